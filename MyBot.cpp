@@ -3,6 +3,7 @@
 #include "hlt/log.hpp"
 
 #include "hlt/bot_controller.hpp"
+#include "hlt/bot_server.hpp"
 
 #include <random>
 #include <ctime>
@@ -11,6 +12,16 @@ using namespace std;
 using namespace hlt;
 
 int main(int argc, char* argv[]) {
+    // MyBot --server <socket_path> [workers] [seed]: host many games in this process
+    if (argc > 2 && string(argv[1]) == "--server") {
+        ServerOptions options;
+        options.socket_path = argv[2];
+        options.workers = argc > 3 ? stoi(argv[3]) : 0;
+        options.bot_name = "Colinatole";
+        options.rng_seed = argc > 4 ? static_cast<unsigned int>(stoul(argv[4])) : static_cast<unsigned int>(time(nullptr));
+        return run_bot_server(options);
+    }
+
     unsigned int rng_seed;
     if (argc > 1) {
         rng_seed = static_cast<unsigned int>(stoul(argv[1]));
@@ -22,18 +33,23 @@ int main(int argc, char* argv[]) {
 
     Game game;
 
-    game.ready("Colinatole");
-
+    // Use the initialization window before ready() to precompute tables
     BotController bot(rng);
+    bot.init(game, STARTUP_BUDGET_MS);
+
+    game.ready("Colinatole");
 
     for (;;) {
         game.update_frame();
 
-        vector<Command> command_queue = bot.play_turn(game);
+        const vector<Command>& command_queue = bot.play_turn(game);
 
         if (!game.end_turn(command_queue)) {
             break;
         }
+
+        // The engine and the other bots play this turn meanwhile
+        bot.speculate(game);
     }
 
     return 0;
@@ -0,0 +1,117 @@
+#include "bot_attraction_field.hpp"
+
+#include "bot_mining.hpp"
+
+#include <algorithm>
+
+void AttractionField::smooth_columns(vector<float>& grid, int w, int h) {
+    const SimdKernels& kernels = simd_kernels();
+    const float a = ATTRACTION_DECAY;
+    smoothed_.resize(grid.size());
+    carry_.assign(w, 0.0f);
+
+    // Forward: smoothed = sum_{k >= 0} a^k grid[y - k]; the first lap only warms up the wrap-around term.
+    // Every row step updates all w columns at once.
+    for (int lap = 0; lap < 2; ++lap) {
+        for (int y = 0; y < h; ++y) {
+            kernels.decay_step(carry_.data(), &grid[y * w], w, a);
+            if (lap == 1) std::copy(carry_.begin(), carry_.end(), smoothed_.begin() + y * w);
+        }
+    }
+
+    // Backward: add sum_{k >= 1} a^k grid[y + k]
+    std::fill(carry_.begin(), carry_.end(), 0.0f);
+    for (int y = h - 1; y >= 0; --y) kernels.decay_step(carry_.data(), &grid[y * w], w, a);
+    for (int y = h - 1; y >= 0; --y) kernels.decay_accumulate(&smoothed_[y * w], carry_.data(), &grid[y * w], w, a);
+
+    grid.swap(smoothed_);
+}
+
+void AttractionField::transpose(const vector<float>& in, vector<float>& out, int w, int h) {
+    out.resize(in.size());
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) out[x * h + y] = in[y * w + x];
+    }
+}
+
+void AttractionField::update(GameMap* game_map_ptr, const vector<vector<bool>>& inspired) {
+    width_ = game_map_ptr->width;
+    height_ = game_map_ptr->height;
+    int cells = width_ * height_;
+    field_.resize(cells);
+    uphill_.resize(cells);
+    peak_.resize(cells);
+
+    for (int y = 0; y < height_; ++y) {
+        for (int x = 0; x < width_; ++x) {
+            int halite = game_map_ptr->cells[y][x].halite;
+            float value = static_cast<float>(halite * (inspired[y][x] ? INSPIRED_MULTIPLIER : 1));
+            // Same poor-cell penalty as the target scan
+            if (halite < MIN_TARGET_HALITE) value *= 0.25f;
+            field_[y * width_ + x] = value;
+        }
+    }
+
+    // Rows are smoothed as the columns of the transposed field
+    for (int pass = 0; pass < ATTRACTION_PASSES; ++pass) {
+        smooth_columns(field_, width_, height_);
+        transpose(field_, transposed_, width_, height_);
+        smooth_columns(transposed_, height_, width_);
+        transpose(transposed_, field_, height_, width_);
+    }
+
+    // Steepest-ascent neighbour of every cell (staying put on ties, so peaks point to themselves)
+    for (int y = 0; y < height_; ++y) {
+        const float* row = &field_[y * width_];
+        const float* up = &field_[(y == 0 ? height_ - 1 : y - 1) * width_];
+        const float* down = &field_[(y == height_ - 1 ? 0 : y + 1) * width_];
+        int up_base = static_cast<int>(up - field_.data());
+        int down_base = static_cast<int>(down - field_.data());
+        for (int x = 0; x < width_; ++x) {
+            int left = x == 0 ? width_ - 1 : x - 1;
+            int right = x == width_ - 1 ? 0 : x + 1;
+
+            int best = y * width_ + x;
+            float best_value = row[x];
+            if (up[x] > best_value) { best_value = up[x]; best = up_base + x; }
+            if (down[x] > best_value) { best_value = down[x]; best = down_base + x; }
+            if (row[right] > best_value) { best_value = row[right]; best = y * width_ + right; }
+            if (row[left] > best_value) { best = y * width_ + left; }
+            uphill_[y * width_ + x] = best;
+        }
+    }
+
+    // Follow uphill paths to their peak, memoizing every cell on the way (O(cells) overall).
+    // The ascent is strict, so paths can't loop.
+    std::fill(peak_.begin(), peak_.end(), -1);
+    peaks_.clear();
+    for (int start = 0; start < cells; ++start) {
+        path_.clear();
+        int cell = start;
+        while (peak_[cell] < 0 && uphill_[cell] != cell) {
+            path_.push_back(cell);
+            cell = uphill_[cell];
+        }
+        if (peak_[cell] < 0) {
+            peak_[cell] = cell;
+            peaks_.push_back(cell);
+        }
+        for (int on_path : path_) peak_[on_path] = peak_[cell];
+    }
+}
+
+Position AttractionField::best_peak(const Position& from) const {
+    Position best = from;
+    float best_score = -1.0f;
+    for (int cell : peaks_) {
+        int dx = std::abs(cell % width_ - from.x);
+        int dy = std::abs(cell / width_ - from.y);
+        int distance = std::min(dx, width_ - dx) + std::min(dy, height_ - dy);
+        float score = field_[cell] / static_cast<float>(distance + 1);
+        if (score > best_score) {
+            best_score = score;
+            best = cell_position(cell);
+        }
+    }
+    return best;
+}
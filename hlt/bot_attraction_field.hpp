@@ -0,0 +1,59 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+#include "bot_simd.hpp"
+
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Map-wide mining attraction potential.
+//
+// Cell values (halite, inspiration bonus, poor-cell penalty as in the target
+// scan) are smoothed by the kernel ATTRACTION_DECAY^(|dx| + |dy|) on the torus.
+// The kernel is separable, so it is applied as one forward and one backward
+// recursive pass along every column, then every row (as columns of the
+// transposed field); each pass runs two laps around the ring so the
+// wrap-around contributions are included. The whole
+// field is O(cells) per turn, and every cell also gets the local maximum its
+// uphill path leads to, so a ship finds a target far outside SEARCH_RADIUS in O(1).
+class AttractionField {
+public:
+    void update(GameMap* game_map_ptr, const vector<vector<bool>>& inspired);
+
+    float at(const Position& pos) const { return field_[pos.y * width_ + pos.x]; }
+
+    // Neighbour (or pos itself) with the highest potential
+    Position uphill(const Position& pos) const { return cell_position(uphill_[pos.y * width_ + pos.x]); }
+
+    // Local maximum reached by following uphill() from pos
+    Position peak(const Position& pos) const { return cell_position(peak_[pos.y * width_ + pos.x]); }
+
+    // Peak with the best potential / (distance + 1) from pos
+    Position best_peak(const Position& from) const;
+
+    int peak_count() const { return static_cast<int>(peaks_.size()); }
+
+private:
+    Position cell_position(int cell) const { return Position(cell % width_, cell / width_); }
+
+    // Two-sided exponential smoothing of every column of a w x h grid, on the ring, in place
+    void smooth_columns(vector<float>& grid, int w, int h);
+    static void transpose(const vector<float>& in, vector<float>& out, int w, int h);
+
+    int width_ = 0;
+    int height_ = 0;
+    vector<float> field_;
+    vector<float> transposed_;
+    vector<float> smoothed_;
+    vector<float> carry_;
+    vector<int> uphill_;
+    vector<int> peak_;
+    vector<int> path_;
+    vector<int> peaks_;
+};
@@ -9,8 +9,7 @@ using namespace hlt;
 
 // Spawn tuning for 64x64 4 player games
 const int MAX_SHIPS = 24;            // Prevent over-fleeting and self-congestion
-const int STOP_SPAWN_TURNS = 140;    // Stop spawning when game is getting late
-const int HALITE_RESERVE = 1000;     // Keep some halite after spawning for flexibility
+const double SPAWN_MIN_RETURN = 3.0; // Spawn while one more ship is expected to deposit this many times SHIP_COST
 const int CONGESTION_RADIUS = 2;     // Manhattan distance around shipyard
 const int CONGESTION_LIMIT = 3;      // If too many ships are nearby, do not spawn
 
@@ -18,10 +17,65 @@ const int CONGESTION_LIMIT = 3;      // If too many ships are nearby, do not spa
 const int SEARCH_RADIUS = 8;         // How far a ship looks for a good mining cell
 const int MIN_TARGET_HALITE = 120;   // Ignore very poor cells as targets
 const int STAY_MINE_THRESHOLD = 100; // Stay still if current cell has enough halite
+const int CLAIM_SCORE_SHIFT = 7;     // SIMD scan: claimed cells score >> 7 (~x0.01 in the scalar scan)
+const bool USE_ATTRACTION_FIELD = false; // Send ships with a barren window to the best attraction field peak (see tools/bench_kernels)
+const float ATTRACTION_DECAY = 0.8f; // Attraction field kernel: DECAY^(manhattan distance)
+const int ATTRACTION_PASSES = 1;     // Smoothing passes (each one widens the kernel)
+const bool USE_SHIP_ROLLOUTS = false; // Before leaving a cell, compare mining here with going to the target on the forward model (see bot_game_state)
+const int ROLLOUT_DEPTH = 6;         // Turns simulated by each of those rollouts
+const bool USE_TERRITORY = true;     // Prefer cells we reach before any enemy (see bot_territory)
+const int TERRITORY_SCORE_SHIFT = 2; // SIMD scan: cells an enemy reaches first score >> 2
+const bool USE_SPECULATION = true;   // Compute the next turn's territory while waiting for the engine (see bot_speculation)
+const bool USE_TURN_VERIFIER = true; // Check each frame against what our commands should have done (see bot_verifier)
+const int TURN_THREADS = 0;          // Threads for the analyses at the start of each turn (0: one per core; 1 runs them inline)
+
+// Learned move policy
+const char* const POLICY_WEIGHTS_PATH = "policy.weights"; // Exploring ships follow this policy when the file exists (see bot_policy)
+const char* const SHADOW_WEIGHTS_PATH = "shadow.weights"; // Policy run next to the live one, compared but never sent, when the file exists (see bot_shadow)
+const double SHADOW_DEADLINE_MS = 1000.0;                 // Shadow cancelled this long after the turn starts
 
 // Dropoff tuning
 const int DROPOFF_COST = 4000;
 const int MIN_DIST_DROPOFF = 15;     // Mini distance between two dropoffs
-const double REQUIRED_HALITE_RADIUS = 10000.0; // Total halite required in the area around the dropoff
+const double DROPOFF_MIN_RETURN = 1.5;    // Build when the dropoff is expected to bring back this many times its cost
 const int MAX_DROPOFFS = 3;          // Arbitrary limit on number of dropoffs to prevent over-expansion
+const int DROPOFF_SCAN_RADIUS = 4;        // Half-size of the square whose halite is summed for a dropoff site
 const int MIN_SHIPS_RADIUS = 2;           // Minimum number of allied ships required in the area around the dropoff to consider building it
+const double DROPOFF_MIN_TERRITORY = 0.5; // Share of the scanned square we must reach first
+
+// Enemy tracking tuning
+const double ENEMY_MODEL_LEARNING_RATE = 0.2;     // EMA weight of the latest observed move
+const double ENEMY_MIN_MOVE_PROBABILITY = 0.05;   // Floor so that no move is ever considered impossible
+const float DANGER_RISK_THRESHOLD = 0.15f;        // Cells with a higher collision risk are treated as dangerous
+const int RETREAT_ENEMY_DISTANCE = 2;             // Loaded ships this close to an enemy head home
+const double RETREAT_CARGO_FRACTION = 0.6;        // Cargo (fraction of MAX_HALITE) a ship must carry to retreat
+
+// Skirmish tuning
+const bool USE_SKIRMISH_SOLVER = true;   // Solve joint moves for our ships within reach of enemies (see bot_skirmish)
+const int SKIRMISH_MAX_OURS = 4;         // Ships per side in one cluster
+const int SKIRMISH_MAX_THEIRS = 4;
+const int SKIRMISH_BUDGET_US = 100;      // Search time per cluster
+const double SKIRMISH_MIN_GAIN = 100.0;  // Expected halite a joint move must be worth to override the per-ship logic
+const double SKIRMISH_DROP_RECOVERY = 0.5; // Share of the halite dropped by a collision we collect on a cell we reach first
+
+// Deposit scheduling tuning
+const int DEPOSIT_SCHEDULE_HORIZON = 8;  // Arrival slots are booked this many turns ahead
+const int DEPOSIT_HOLD_DISTANCE = 3;     // Ships with a late slot wait only when this close to the deposit
+const int ENDGAME_RECALL_MARGIN = 3;     // Extra turns on top of distance + queue when recalling ships
+const int PILE_IN_SLACK = 2;             // Ships arriving within this many turns of the end pile in on the deposit
+
+// Economy tuning
+const double ECONOMY_RATE_DECAY = 0.95;       // Weight of the past in the income moving averages
+const double ECONOMY_PRIOR_YIELD = 0.1;       // Prior per-ship deposit rate, as a fraction of the mean cell halite
+const double ECONOMY_PRIOR_SHIP_TURNS = 50.0; // Weight of that prior against observed ship-turns
+const double ECONOMY_PRIOR_EFFICIENCY = 0.85; // Deposited / mined before anything was deposited
+const double ECONOMY_CARGO_PER_TRIP = 0.9;    // Cargo brought back per trip, as a fraction of MAX_HALITE
+
+// Startup tuning
+const double STARTUP_BUDGET_MS = 2000.0; // Time allowed for precomputation before ready()
+
+// Debug output
+const bool WRITE_SNAPSHOTS = false;          // Append per-turn grids and ship states to bot-<id>.snap (see tools/snapshot_reader)
+const bool WRITE_DATASET = false;            // Append per-ship crops, states and commands to bot-<id>.dset (see tools/dataset_reader)
+const int DATASET_RADIUS = 4;                // Crop radius of those rows
+const bool WRITE_TELEMETRY = false;          // Append a JSON line of fleet KPIs per game to bot-<id>.telemetry.jsonl (see bot_telemetry)
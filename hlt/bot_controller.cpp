@@ -5,7 +5,10 @@
 #include "bot_navigation.hpp"
 #include "bot_spawn.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
+#include <cstdio>
 
 #ifdef _DEBUG
 # define LOG(X) log::log(X);
@@ -13,104 +16,315 @@
 # define LOG(X)
 #endif
 
-BotController::BotController(mt19937& rng)
-    : rng_(rng) {
+// All false, resized on the first turn only
+static vector<vector<bool>>& clear_grid(vector<vector<bool>>& grid, int width, int height) {
+    if (grid.size() != static_cast<size_t>(height) || grid[0].size() != static_cast<size_t>(width)) {
+        grid.assign(height, vector<bool>(width, false));
+    }
+    else {
+        for (auto& row : grid) std::fill(row.begin(), row.end(), false);
+    }
+    return grid;
 }
 
-vector<Command> BotController::play_turn(Game& game) {
-    int turns_remaining = constants::MAX_TURNS - game.turn_number;
-
-    shared_ptr<Player> me = game.me;
-    unique_ptr<GameMap>& game_map = game.game_map;
-
-    mem_.cleanup_dead_ships(me);
+static CellGrid<uint8_t>& clear_grid(CellGrid<uint8_t>& grid, int width, int height) {
+    if (grid.width() != width || grid.height() != height) grid.resize(width, height);
+    else grid.fill(0);
+    return grid;
+}
 
-    int dynamic_max_ships = (game_map->width * game_map->height) / 18; // ~1 ship for 18 cells
+BotController::BotController(mt19937& rng, int turn_threads)
+    : rng_(rng), turn_threads_(turn_threads) {
+}
 
-    // Collision grid, empty grid initialized to false (indicating all cells are initially unoccupied)
-    vector<vector<bool>> next_turn_occupied(game_map->height, vector<bool>(game_map->width, false));
+void BotController::init(Game& game, double budget_ms) {
+    double total_ms = 0.0;
+    for (const auto& step : build_startup_tables(tables_, game, budget_ms)) {
+        total_ms += step.ms;
+        if (step.skipped) {
+            log::log("init: " + step.name + " skipped (budget of " + to_string(budget_ms) + " ms spent)");
+        }
+        else {
+            log::log("init: " + step.name + " took " + to_string(step.ms) + " ms");
+        }
+    }
+    log::log("init: total " + to_string(total_ms) + " ms, symmetry x=" + to_string(tables_.mirror_x) + " y=" + to_string(tables_.mirror_y));
+
+    // Containers keyed by ship are pre-sized so that the fleet growing does not allocate mid-game
+    size_t ships = entity_reserve(game.game_map->width, game.game_map->height);
+    mem_.reserve(ships);
+    enemy_tracker_.reserve(ships * (game.players.size() - 1));
+    command_queue_.reserve(ships + 1);
+    moves_.reserve(ships);
+    constructs_.reserve(ships);
+    if (USE_SHIP_ROLLOUTS) lookahead_.reserve(ships);
+    if (USE_TURN_VERIFIER) verifier_.reserve(ships, game.game_map->width * game.game_map->height);
+    if (USE_SKIRMISH_SOLVER) skirmish_.reserve(ships, game.game_map->width * game.game_map->height);
+    telemetry_.reserve(constants::MAX_TURNS + 1);
+
+    if (policy_.load(POLICY_WEIGHTS_PATH)) {
+        policy_.reserve(ships);
+        log::log("init: move policy loaded (radius " + to_string(policy_.radius()) + ", " + to_string(policy_.hidden()) + " hidden units)");
+    }
+    else {
+        log::log("init: no move policy, exploring ships use the heuristics");
+    }
+    unique_ptr<LearnedShadowPolicy> shadow_policy(new LearnedShadowPolicy());
+    if (shadow_policy->load(SHADOW_WEIGHTS_PATH)) {
+        shadow_.reset(new ShadowRunner(std::move(shadow_policy)));
+        shadow_->reserve(ships);
+        log::log("init: shadow policy " + string(shadow_->name()) + " loaded, its moves are compared but not sent");
+    }
 
-    vector<vector<uint8_t>> enemy_count(game_map->height, vector<uint8_t>(game_map->width, 0));
-    vector<vector<bool>> inspired(game_map->height, vector<bool>(game_map->width, false));
+    // Kernel selection logs, so it happens here rather than on a worker
+    simd_kernels();
+    scheduler_.reset(new TaskScheduler(turn_threads_));
+    add_turn_tasks();
+    log::log("init: " + to_string(scheduler_->task_count()) + " turn tasks on " + to_string(scheduler_->threads()) + " threads");
 
-	// Danger map (enemy position + 4 adjacent cells)
-    vector<vector<bool>> danger_map(game_map->height, vector<bool>(game_map->width, false));
+    if (WRITE_SNAPSHOTS) {
+        snapshots_.reset(new SnapshotWriter());
+        if (!snapshots_->open("bot-" + to_string(game.my_id) + ".snap", game, ships)) snapshots_.reset();
+    }
+    if (WRITE_DATASET) {
+        dataset_.reset(new DatasetWriter());
+        if (!dataset_->open("bot-" + to_string(game.my_id) + ".dset", game, DATASET_RADIUS, ships)) dataset_.reset();
+    }
+}
 
-    auto add_enemy_influence = [&](const Position& epos) {
-        // Count enemies in a diamond (manhattan) radius around each enemy position.
-        for (int dy = -INSPIRATION_RADIUS; dy <= INSPIRATION_RADIUS; ++dy) {
-            int rem = INSPIRATION_RADIUS - std::abs(dy);
-            for (int dx = -rem; dx <= rem; ++dx) {
-                Position p(epos.x + dx, epos.y + dy);
-                p = game_map->normalize(p);
-                uint8_t& c = enemy_count[p.y][p.x];
-                if (c < 255) ++c;
+// What the per-turn tasks read and write, as TaskScheduler masks (the game itself is read-only)
+enum TurnData : uint64_t {
+    DATA_SHIP_MEMORY = 1 << 0,
+    DATA_DEPOSITS = 1 << 2,
+    DATA_ECONOMY = 1 << 3,
+    DATA_RISK_MAP = 1 << 4,
+    DATA_OCCUPIED = 1 << 5,
+    DATA_INSPIRED = 1 << 6,
+    DATA_CLAIMED = 1 << 7,
+    DATA_MINING_GRIDS = 1 << 8,
+    DATA_TERRITORY = 1 << 9,
+    DATA_ATTRACTION = 1 << 10,
+    DATA_LOOKAHEAD = 1 << 11,
+    DATA_SKIRMISH = 1 << 12,
+    DATA_POLICY = 1 << 14
+};
+
+void BotController::add_turn_tasks() {
+    // Remaining halite and income rates, from this turn's engine deltas
+    scheduler_->add("economy", 0, DATA_ECONOMY, [this]() {
+        economy_.update(*turn_game_);
+    });
+
+    // Collision risk map (graded, from the per-ship enemy movement models)
+    scheduler_->add("enemy tracker", 0, DATA_RISK_MAP, [this]() {
+        enemy_tracker_.update(*turn_game_);
+    });
+
+    scheduler_->add("occupancy", 0, DATA_OCCUPIED, [this]() {
+        Game& game = *turn_game_;
+        const GameMap& game_map = *game.game_map;
+
+        // Collision grid, empty grid initialized to false (indicating all cells are initially unoccupied)
+        CellGrid<uint8_t>& next_turn_occupied = clear_grid(next_turn_occupied_, game_map.width, game_map.height);
+
+        // Marking enemy ship positions as occupied to avoid crashing into them
+        // Optional but safe to start with
+        // UPGRADE: can change for more aggressive play later
+        // (danger around them is graded by the enemy tracker)
+        for (const auto& player_ptr : game.players) {
+            if (player_ptr->id == game.my_id) continue; // Ignoring our own ships for now
+            for (const auto& ship_pair : player_ptr->ships) {
+                Position pos = ship_pair.second->position;
+                next_turn_occupied[pos.y][pos.x] = true;
             }
         }
-        };
 
-    vector<Command> command_queue;
-
-    // Marking enemy ship positions as occupied to avoid crashing into them
-    // Optional but safe to start with
-    // UPGRADE: can change for more aggressive play later
-    for (const auto& player_ptr : game.players) {
-        if (player_ptr->id == me->id) continue; // Ignoring our own ships for now
-
-        for (const auto& ship_pair : player_ptr->ships) {
-            // Marking enemy ship's current position as dangerous (simplification, since they can move)
-            // UPGRADE: Marking adjacent cells as well to account for their possible moves
+        // Collision prevention: pre-pass for still ships (marking allied ships that will necessarily stay still in advance)
+        for (const auto& ship_pair : game.me->ships) {
             Position pos = ship_pair.second->position;
-
-            // Enemy cell is dangerous and occupied
             next_turn_occupied[pos.y][pos.x] = true;
-            danger_map[pos.y][pos.x] = true;
+        }
+    });
+
+    scheduler_->add("inspiration", 0, DATA_INSPIRED, [this]() {
+        Game& game = *turn_game_;
+        const GameMap& game_map = *game.game_map;
 
-			// The 4 adjacent cells are also dangerous (potentially occupied next turn)
-            for (const auto& dir : ALL_CARDINALS) {
-                Position adj = game_map->normalize(pos.directional_offset(dir));
-                danger_map[adj.y][adj.x] = true;
+        // Enemies within INSPIRATION_RADIUS of each cell (padded grid, stamped by the diamond kernel)
+        if (enemy_count_.width != game_map.width || enemy_count_.height != game_map.height) {
+            enemy_count_.resize(game_map.width, game_map.height, INSPIRATION_RADIUS);
+        }
+        enemy_count_.fill(0);
+        vector<vector<bool>>& inspired = clear_grid(inspired_, game_map.width, game_map.height);
+
+        // Inspiration counting (uses current enemy positions)
+        for (const auto& player_ptr : game.players) {
+            if (player_ptr->id == game.my_id) continue;
+            for (const auto& ship_pair : player_ptr->ships) {
+                Position pos = ship_pair.second->position;
+                simd_kernels().diamond_add(enemy_count_, pos.x, pos.y, INSPIRATION_RADIUS);
             }
+        }
+        enemy_count_.fold_padding();
 
-            // Inspiration counting (uses current enemy positions)
-            add_enemy_influence(pos);
+        for (int y = 0; y < game_map.height; ++y) {
+            const int32_t* counts = enemy_count_.row(y);
+            for (int x = 0; x < game_map.width; ++x) {
+                inspired[y][x] = (counts[x] >= INSPIRATION_SHIPS_REQUIRED);
+            }
+        }
+    });
+
+    scheduler_->add("ship memory", 0, DATA_SHIP_MEMORY | DATA_CLAIMED, [this]() {
+        Game& game = *turn_game_;
+        mem_.cleanup_dead_ships(game.me);
+
+        // Anti-clumping grid
+        vector<vector<bool>>& claimed_targets = clear_grid(claimed_targets_, game.game_map->width, game.game_map->height);
+
+        // Pre-filling with targets of ships that are already in MINING mode
+        for (const auto& ship_iterator : game.me->ships) {
+            const shared_ptr<Ship>& ship = ship_iterator.second;
+            mem_.ensure_initialized(ship);
+
+            if (mem_.ship_status[ship->id] == ShipState::MINING) {
+                Position target = mem_.ship_target[ship->id];
+                // If the ship is not already on its target, it reserves it
+                if (ship->position != target) {
+                    claimed_targets[target.y][target.x] = true;
+                }
+            }
         }
+    });
+
+    // Arrival slots at our deposits are rebooked from scratch every turn, queued behind last turn's returning ships
+    scheduler_->add("deposits", DATA_SHIP_MEMORY, DATA_DEPOSITS, [this]() {
+        Game& game = *turn_game_;
+        deposit_scheduler_.begin_turn(game.me, game.game_map.get(), mem_, constants::MAX_TURNS - game.turn_number);
+    });
+
+    // Padded halite / inspiration / claim grids for the SIMD target scan and area sums
+    scheduler_->add("mining grids", DATA_INSPIRED | DATA_CLAIMED, DATA_MINING_GRIDS, [this]() {
+        mining_grids_.update(turn_game_->game_map.get(), inspired_, claimed_targets_);
+    });
+
+    // Who reaches each cell first; cells the enemy gets to first are worth less as targets
+    if (USE_TERRITORY) {
+        scheduler_->add("territory", 0, DATA_TERRITORY, [this]() {
+            if (speculator_) {
+                speculator_->reconcile(*turn_game_, *tables_.geometry, territory_);
+            }
+            else {
+                territory_.update(*turn_game_, *tables_.geometry);
+            }
+        });
+        scheduler_->add("territory scores", DATA_TERRITORY, DATA_MINING_GRIDS, [this]() {
+            penalize_enemy_territory(mining_grids_, territory_);
+        });
     }
 
-    for (int y = 0; y < game_map->height; ++y) {
-        for (int x = 0; x < game_map->width; ++x) {
-            inspired[y][x] = (enemy_count[y][x] >= INSPIRATION_SHIPS_REQUIRED);
-        }
+    // Map-wide smoothed mining value, for ships whose window has nothing to offer
+    if (USE_ATTRACTION_FIELD) {
+        scheduler_->add("attraction", DATA_INSPIRED, DATA_ATTRACTION, [this]() {
+            attraction_.update(turn_game_->game_map.get(), inspired_);
+        });
     }
 
-    // Collision prevention: pre-pass for still ships (marking allied ships that will necessarily stay still in advance)
-    for (const auto& ship_pair : me->ships) {
-        Position pos = ship_pair.second->position;
-        next_turn_occupied[pos.y][pos.x] = true;
+    // Joint moves where our ships and enemy ships can collide
+    if (USE_SKIRMISH_SOLVER) {
+        scheduler_->add("skirmish", DATA_RISK_MAP | DATA_TERRITORY | DATA_ECONOMY, DATA_SKIRMISH, [this]() {
+            Game& game = *turn_game_;
+            double ship_value = economy_.ship_return(constants::MAX_TURNS - game.turn_number);
+            skirmish_.solve(game, enemy_tracker_, tables_, USE_TERRITORY ? &territory_ : nullptr, ship_value);
+        });
     }
 
-    // Anti-clumping grid
-    vector<vector<bool>> claimed_targets(game_map->height, vector<bool>(game_map->width, false));
+    // Root state of the per-ship rollouts
+    if (USE_SHIP_ROLLOUTS) {
+        scheduler_->add("lookahead", 0, DATA_LOOKAHEAD, [this]() {
+            lookahead_.state.load(*turn_game_->game_map, *turn_game_->me, tables_, lookahead_.tiles);
+        });
+    }
 
-	// Pre-filling with targets of ships that are already in MINING mode
-    for (const auto& ship_iterator : me->ships) {
-        shared_ptr<Ship> ship = ship_iterator.second;
-        mem_.ensure_initialized(ship);
+    // Move scores of the whole fleet, one batch
+    if (policy_.loaded()) {
+        scheduler_->add("policy", 0, DATA_POLICY, [this]() {
+            policy_.evaluate(*turn_game_);
+        });
+    }
+}
 
-        if (mem_.ship_status[ship->id] == ShipState::MINING) {
-            Position target = mem_.ship_target[ship->id];
-			// If the ship is not already on its target, it reserves it
-            if (ship->position != target) {
-                claimed_targets[target.y][target.x] = true;
-            }
+const vector<Command>& BotController::play_turn(Game& game) {
+    std::chrono::steady_clock::time_point turn_start = std::chrono::steady_clock::now();
+    int turns_remaining = constants::MAX_TURNS - game.turn_number;
+
+    shared_ptr<Player> me = game.me;
+    unique_ptr<GameMap>& game_map = game.game_map;
+
+    // What last turn's commands did, against what they should have done
+    if (USE_TURN_VERIFIER) {
+        verifier_.verify(game);
+        if (verifier_.last_mismatches() > 0) {
+            LOG(verifier_.summary());
+        }
+    }
+    telemetry_.observe(game, mem_);
+
+    // Bank before this turn's dropoff planning deducts from it
+    Halite bank = me->halite;
+
+    // Per-turn analyses (see add_turn_tasks), spread over the scheduler's threads
+    turn_game_ = &game;
+    scheduler_->run();
+    turn_game_ = nullptr;
+    LOG("turn tasks: " + scheduler_->timings());
+
+    // Per-turn grids and the command queue are members cleared in place, so a turn does not allocate
+    command_queue_.clear();
+    moves_.clear();
+    constructs_.clear();
+    vector<Command>& command_queue = command_queue_;
+    // Every ship move goes to the engine and, as (id, direction), to the turn's consumers
+    auto queue_move = [this, &command_queue](const shared_ptr<Ship>& ship, Direction direction) {
+        command_queue.push_back(ship->move(direction));
+        moves_.emplace_back(ship->id, direction);
+    };
+    CellGrid<uint8_t>& next_turn_occupied = next_turn_occupied_;
+    const vector<vector<bool>>& inspired = inspired_;
+    vector<vector<bool>>& claimed_targets = claimed_targets_;
+    const CellGrid<float>& risk_map = enemy_tracker_.risk_map();
+    const TerritoryField* territory = USE_TERRITORY ? &territory_ : nullptr;
+
+    // Skirmish moves are reserved before any other ship picks a cell: they leave their cells first,
+    // then land where the solver sent them (an enemy's cell included)
+    if (USE_SKIRMISH_SOLVER) {
+        for (const auto& move : skirmish_.moves()) {
+            Position pos = me->ships.find(move.first)->second->position;
+            next_turn_occupied.at(game_map->cell_id(pos)) = false;
+        }
+        for (const auto& move : skirmish_.moves()) {
+            const shared_ptr<Ship>& ship = me->ships.find(move.first)->second;
+            next_turn_occupied.at(game_map->neighbour(game_map->cell_id(ship->position), move.second)) = true;
+            queue_move(ship, move.second);
         }
     }
 
+    // The shadow policy plays the same turn on its own thread while the live loop runs
+    if (shadow_) {
+        shadow_->start(
+            game, tables_, inspired, risk_map, territory, next_turn_occupied, mem_, skirmish_.moves(),
+            turn_start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(SHADOW_DEADLINE_MS))
+        );
+    }
+
 	// main ship loop
     for (const auto& ship_iterator : me->ships) {
         shared_ptr<Ship> ship = ship_iterator.second;
         EntityId id = ship->id;
 
+        // Already moved by the skirmish solver
+        if (USE_SKIRMISH_SOLVER && skirmish_.has_move(id)) continue;
+
         // Freeing the cell while thinking
         // even if we end up staying still, we will reserve it again with finalize_and_reserve_move
         next_turn_occupied[ship->position.y][ship->position.x] = false;
@@ -118,28 +332,25 @@ vector<Command> BotController::play_turn(Game& game) {
         // Dropoff construction logic
         // Construction is considered only if we have the budget and enough time left
         // Keeping a security margin (SHIP_COST) to be able to spawn after if needed
-        if (try_build_dropoff(ship, me, game_map.get(), turns_remaining, command_queue, next_turn_occupied)) {
+        if (try_build_dropoff(ship, me, game_map.get(), mining_grids_.halite, economy_, territory, turns_remaining, command_queue, next_turn_occupied)) {
+            constructs_.push_back(id);
             continue; // Skip the rest of the logic for this ship since it's now building a dropoff
         }
 
         mem_.ensure_initialized(ship);
 
-        update_ship_state(ship, me, game_map.get(), turns_remaining, mem_);
+        update_ship_state(ship, me, game_map.get(), turns_remaining, deposit_scheduler_, territory, mem_);
 
         // Ensure the ship can afford to move from its current cell
         {
-            int origin_halite = game_map->at(ship)->halite;
-            int ratio = constants::MOVE_COST_RATIO;
-
             // Engine move cost is based on halite in the origin cell
-            int move_cost = (origin_halite + ratio - 1) / ratio;
+            int move_cost = tables_.cost_to_move(game_map->at(ship)->halite);
 
             // If we cannot afford to move, force STILL this turn.
             // This keeps next_turn_occupied consistnet with what will actually happen in the engine
             if (ship->halite < move_cost) {
-                command_queue.push_back(
-                    finalize_and_reserve_move(ship, game_map.get(), Direction::STILL, next_turn_occupied)
-                );
+                telemetry_.count_stuck(id);
+                queue_move(ship, finalize_and_reserve_move(ship, game_map.get(), Direction::STILL, next_turn_occupied, &telemetry_));
                 continue;
             }
         }
@@ -149,25 +360,90 @@ vector<Command> BotController::play_turn(Game& game) {
         bool is_ship_inspired = inspired[ship->position.y][ship->position.x]; // Get inspiration status
 
         // Moving logic based on state
+        DepositBooking booking;
         if (mem_.ship_status[id] == ShipState::RETURNING) {
+            booking = deposit_scheduler_.assign(ship, game_map.get());
+
             intended_direction = decide_returning_direction(
-                ship, me, game_map.get(), next_turn_occupied, danger_map, is_ship_inspired
+                ship, booking, game_map.get(), next_turn_occupied, risk_map, is_ship_inspired
             );
         }
+        else if (policy_.loaded()) {
+            intended_direction = policy_.choose(*ship, game_map.get(), next_turn_occupied);
+        }
         else {
             intended_direction = decide_mining_direction(
-                ship, game_map.get(), mem_, next_turn_occupied, danger_map, inspired, claimed_targets
+                ship, game_map.get(), mem_, mining_grids_, attraction_, USE_SHIP_ROLLOUTS ? &lookahead_ : nullptr, next_turn_occupied, risk_map, inspired, claimed_targets
             );
         }
 
         intended_direction = apply_move_cost_safety(ship, game_map.get(), intended_direction);
 
-        command_queue.push_back(
-            finalize_and_reserve_move(ship, game_map.get(), intended_direction, next_turn_occupied)
-        );
+        if (booking.pile_in) {
+            queue_move(ship, finalize_pile_in_move(ship, game_map.get(), intended_direction, booking.deposit, next_turn_occupied, &telemetry_));
+        }
+        else {
+            queue_move(ship, finalize_and_reserve_move(ship, game_map.get(), intended_direction, next_turn_occupied, &telemetry_));
+        }
+    }
+
+    try_spawn(me, game_map.get(), economy_, turns_remaining, next_turn_occupied, command_queue, &telemetry_);
+
+    if (shadow_) {
+        shadow_->finish(command_queue, mem_);
+        LOG("shadow: " + to_string(shadow_->last_agreed()) + "/" + to_string(shadow_->last_compared()) + " moves agreed" + (shadow_->last_cancelled() ? " (cancelled)" : "") + ", differing " + shadow_->last_disagreements());
+        if (turns_remaining == 0) log::log(shadow_->summary());
+    }
+
+    if (USE_TURN_VERIFIER) {
+        verifier_.predict(game, bank, inspired, command_queue);
+        if (turns_remaining == 0) log::log(verifier_.summary());
+    }
+    telemetry_.record_moves(game, inspired, moves_);
+    if (turns_remaining == 0) {
+        log::log(telemetry_.summary());
+        if (WRITE_TELEMETRY) write_telemetry(game);
     }
 
-    try_spawn(me, game_map.get(), turns_remaining, next_turn_occupied, command_queue, dynamic_max_ships);
+    if (snapshots_) {
+        snapshots_->write_turn(game, mem_, risk_map, inspired, claimed_targets, next_turn_occupied, moves_, constructs_);
+    }
+    if (dataset_) {
+        dataset_->write_turn(game, mem_, inspired, moves_, constructs_);
+    }
+
+    LOG("economy: " + to_string(economy_.remaining_halite()) + " left, income " + to_string(economy_.income_rate(me->id)) + "/turn, ship return " + to_string(economy_.ship_return(turns_remaining)));
+    LOG("territory: " + to_string(territory_.our_cell_count()) + " cells reached first");
+    if (speculator_) {
+        LOG("speculation: our side reused " + to_string(speculator_->ours_reused()) + ", enemy side " + to_string(speculator_->enemies_reused()) + " of " + to_string(speculator_->reconciled_turns()) + " turns");
+    }
+    if (USE_SKIRMISH_SOLVER) {
+        LOG("skirmish: " + to_string(skirmish_.moves().size()) + " ships moved, " + to_string(skirmish_.engagements()) + " engagements in " + to_string(skirmish_.clusters()) + " clusters, " + to_string(skirmish_.timeouts()) + " out of time");
+    }
+    if (policy_.loaded()) {
+        LOG("policy: " + to_string(me->ships.size()) + " ships scored in " + to_string(policy_.last_us()) + " us");
+    }
 
     return command_queue;
 }
+
+void BotController::write_telemetry(const Game& game) const {
+    string path = "bot-" + to_string(game.my_id) + ".telemetry.jsonl";
+    FILE* file = std::fopen(path.c_str(), "a");
+    if (!file) {
+        log::log("telemetry: cannot open " + path);
+        return;
+    }
+    string line = telemetry_.summary_json(game) + "\n";
+    std::fwrite(line.data(), 1, line.size(), file);
+    std::fclose(file);
+}
+
+void BotController::speculate(const Game& game) {
+    if (!USE_SPECULATION || !USE_TERRITORY) return;
+    if (!speculator_) {
+        speculator_.reset(new TurnSpeculator());
+        speculator_->reserve(entity_reserve(game.game_map->width, game.game_map->height));
+    }
+    speculator_->start(game, command_queue_, *tables_.geometry);
+}
@@ -4,8 +4,26 @@
 #include "constants.hpp"
 #include "log.hpp"
 
+#include "bot_attraction_field.hpp"
+#include "bot_dataset.hpp"
+#include "bot_deposit_scheduler.hpp"
+#include "bot_economy.hpp"
+#include "bot_enemy_tracker.hpp"
+#include "bot_game_state.hpp"
+#include "bot_policy.hpp"
+#include "bot_precompute.hpp"
+#include "bot_scheduler.hpp"
+#include "bot_shadow.hpp"
 #include "bot_ship_memory.hpp"
+#include "bot_simd.hpp"
+#include "bot_skirmish.hpp"
+#include "bot_snapshot.hpp"
+#include "bot_speculation.hpp"
+#include "bot_telemetry.hpp"
+#include "bot_territory.hpp"
+#include "bot_verifier.hpp"
 
+#include <memory>
 #include <random>
 #include <vector>
 
@@ -14,11 +32,56 @@ using namespace hlt;
 
 class BotController {
 public:
-    explicit BotController(mt19937& rng);
+    // turn_threads: threads of the per-turn analyses (see TaskScheduler; 1 runs them inline)
+    explicit BotController(mt19937& rng, int turn_threads = TURN_THREADS);
 
-    vector<Command> play_turn(Game& game);
+    // Startup stage: runs after the map is parsed and before game.ready(),
+    // precomputing tables within budget_ms and logging each step's duration
+    void init(Game& game, double budget_ms);
+
+    const StartupTables& tables() const { return tables_; }
+
+    // Commands of the turn (valid until the next play_turn)
+    const vector<Command>& play_turn(Game& game);
+
+    // Start precomputing the next turn on a background thread; call once the commands are sent
+    void speculate(const Game& game);
 
 private:
+    // The analyses at the start of play_turn, as scheduler tasks
+    void add_turn_tasks();
+
+    // Append the game's telemetry summary to bot-<id>.telemetry.jsonl
+    void write_telemetry(const Game& game) const;
+
     mt19937& rng_;
+    int turn_threads_;
     ShipMemory mem_;
+    StartupTables tables_;
+    EnemyTracker enemy_tracker_;
+    DepositScheduler deposit_scheduler_;
+    EconomyTracker economy_;
+    MiningGrids mining_grids_;
+    AttractionField attraction_;
+    ShipLookahead lookahead_;
+    TerritoryField territory_;
+    TurnVerifier verifier_;
+    FleetTelemetry telemetry_;
+    SkirmishSolver skirmish_;
+    MovePolicy policy_;
+    PaddedGrid enemy_count_;
+    CellGrid<uint8_t> next_turn_occupied_;
+    vector<vector<bool>> inspired_;
+    vector<vector<bool>> claimed_targets_;
+    vector<Command> command_queue_;
+    vector<pair<EntityId, Direction>> moves_;  // The turn's ship moves, in command order
+    vector<EntityId> constructs_;             // Ships turned into dropoffs this turn
+    unique_ptr<SnapshotWriter> snapshots_;
+    unique_ptr<DatasetWriter> dataset_;
+    unique_ptr<TurnSpeculator> speculator_;
+    unique_ptr<ShadowRunner> shadow_;
+
+    // Game of the turn being played, for the tasks
+    Game* turn_game_ = nullptr;
+    unique_ptr<TaskScheduler> scheduler_;
 };
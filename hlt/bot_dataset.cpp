@@ -0,0 +1,117 @@
+#include "bot_dataset.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+template <typename T>
+static void put(uint8_t* column, int row, T value) {
+    std::memcpy(column + static_cast<size_t>(row) * sizeof(T), &value, sizeof(T));
+}
+
+// DatasetAction of a move: its neighbour slot
+static_assert(DATASET_STILL == NEIGHBOUR_STILL, "dataset actions follow the neighbour slots");
+static uint8_t action_of(Direction direction) {
+    return static_cast<uint8_t>(neighbour_slot(direction));
+}
+
+static const uint8_t OCCUPANT_FLAGS[] = { 0, DATASET_ALLY, DATASET_ENEMY };
+
+bool DatasetWriter::open(const string& path, const Game& game, int radius, size_t ships) {
+    if (!file_.open(path)) {
+        log::log("dataset: cannot open " + path);
+        return false;
+    }
+    inputs_ = PolicyInputs(radius);
+    actions_.reserve(ships);
+    ships_.reserve(ships);
+
+    vector<uint8_t> record = file_.take_buffer();
+    record_begin(record, DATASET_GAME_MAGIC);
+    DatasetGameHeader header;
+    header.version = DATASET_VERSION;
+    header.width = static_cast<uint16_t>(game.game_map->width);
+    header.height = static_cast<uint16_t>(game.game_map->height);
+    header.my_id = static_cast<uint16_t>(game.my_id);
+    header.num_players = static_cast<uint16_t>(game.players.size());
+    header.radius = static_cast<uint16_t>(radius);
+    header.column_count = DATASET_COLUMN_COUNT;
+    header.max_turns = static_cast<uint32_t>(constants::MAX_TURNS);
+    record_append(record, header);
+    record_close(record);
+    file_.submit(std::move(record));
+    return true;
+}
+
+void DatasetWriter::write_turn(
+    const Game& game,
+    const ShipMemory& mem,
+    const vector<vector<bool>>& inspired,
+    const vector<pair<EntityId, Direction>>& moves,
+    const vector<EntityId>& constructs
+) {
+    if (!file_.is_open()) return;
+
+    const shared_ptr<Player>& me = game.me;
+    int radius = inputs_.radius();
+    inputs_.prepare(game);
+
+    actions_.clear();
+    for (const auto& move : moves) actions_.emplace_back(move.first, action_of(move.second));
+    for (EntityId id : constructs) actions_.emplace_back(id, DATASET_CONSTRUCT);
+    std::sort(actions_.begin(), actions_.end());
+
+    ships_.clear();
+    for (const auto& ship_pair : me->ships) ships_.push_back(ship_pair.second.get());
+    std::sort(ships_.begin(), ships_.end(), [](const Ship* a, const Ship* b) { return a->id < b->id; });
+    int rows = static_cast<int>(ships_.size());
+
+    vector<uint8_t> record = file_.take_buffer();
+    record_begin(record, DATASET_ROWS_MAGIC);
+    DatasetBatchHeader header;
+    header.turn = static_cast<uint32_t>(game.turn_number);
+    header.halite = static_cast<uint32_t>(me->halite);
+    header.rows = static_cast<uint16_t>(rows);
+    header.reserved = 0;
+    record_append(record, header);
+
+    array<size_t, DATASET_COLUMN_COUNT + 1> columns = dataset_columns(rows, radius);
+    size_t base = record.size();
+    record.resize(base + columns[DATASET_COLUMN_COUNT], 0);
+    auto column = [&](DatasetColumn c) { return &record[base + columns[c]]; };
+
+    int side = 2 * radius + 1;
+    int crop = side * side;
+    for (int row = 0; row < rows; ++row) {
+        const Ship& ship = *ships_[row];
+        Position target = ship.position;
+        auto target_it = mem.ship_target.find(ship.id);
+        if (target_it != mem.ship_target.end()) target = target_it->second;
+        ShipState status = ShipState::MINING;
+        auto status_it = mem.ship_status.find(ship.id);
+        if (status_it != mem.ship_status.end()) status = status_it->second;
+        uint8_t action = DATASET_NO_COMMAND;
+        auto action_it = std::lower_bound(actions_.begin(), actions_.end(), make_pair(ship.id, static_cast<uint8_t>(0)));
+        if (action_it != actions_.end() && action_it->first == ship.id) action = action_it->second;
+
+        put(column(DATASET_SHIP_ID), row, static_cast<uint32_t>(ship.id));
+        put(column(DATASET_X), row, static_cast<uint16_t>(ship.position.x));
+        put(column(DATASET_Y), row, static_cast<uint16_t>(ship.position.y));
+        put(column(DATASET_CARGO), row, static_cast<uint16_t>(ship.halite));
+        put(column(DATASET_DEPOSIT_DISTANCE), row, static_cast<uint16_t>(PolicyInputs::deposit_distance(game, ship)));
+        put(column(DATASET_TARGET_X), row, static_cast<uint16_t>(target.x));
+        put(column(DATASET_TARGET_Y), row, static_cast<uint16_t>(target.y));
+        put(column(DATASET_STATUS), row, static_cast<uint8_t>(status));
+        put(column(DATASET_ACTION), row, action);
+
+        uint8_t* halite = column(DATASET_HALITE_CROP) + static_cast<size_t>(row) * crop * sizeof(uint16_t);
+        uint8_t* flags = column(DATASET_FLAGS_CROP) + static_cast<size_t>(row) * crop;
+        inputs_.crop(game, ship, [&](int i, const MapCell& cell, PolicyInputs::Occupant occupant) {
+            put(halite, i, static_cast<uint16_t>(std::min(cell.halite, 65535)));
+            flags[i] = static_cast<uint8_t>(OCCUPANT_FLAGS[occupant] | (inspired[cell.position.y][cell.position.x] ? DATASET_INSPIRED : 0));
+        });
+    }
+
+    record_close(record);
+    file_.submit(std::move(record));
+    rows_written_ += rows;
+}
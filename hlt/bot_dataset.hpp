@@ -0,0 +1,136 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+#include "bot_policy.hpp"
+#include "bot_record_file.hpp"
+#include "bot_ship_memory.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Training dataset: a record file (see bot_record_file.hpp) of per-ship
+// decisions. A DSET record opens every game appended to the file and is
+// followed by one ROWS record per turn, each holding one row per ship of ours
+// in columnar layout: every DatasetColumn is a contiguous array over the
+// batch's rows, padded to 4 bytes, in enum order (see dataset_columns).
+//
+// ROWS payload:
+//   DatasetBatchHeader
+//   the columns
+//
+// Crops are the (2R+1)^2 square around the ship, cell (dx, dy) at
+// (dy + R) * (2R + 1) + (dx + R), R from the game header: the window, ship
+// marks and deposit distance of the move policy's inputs (see PolicyInputs).
+static const uint32_t DATASET_GAME_MAGIC = 0x54455344; // "DSET"
+static const uint32_t DATASET_ROWS_MAGIC = 0x53574f52; // "ROWS"
+static const uint32_t DATASET_VERSION = 1;
+
+enum DatasetColumn {
+    DATASET_SHIP_ID,      // uint32
+    DATASET_X,            // uint16
+    DATASET_Y,            // uint16
+    DATASET_CARGO,        // uint16
+    DATASET_DEPOSIT_DISTANCE, // uint16, to our nearest shipyard or dropoff
+    DATASET_TARGET_X,     // uint16, ShipMemory target (the ship's cell if none)
+    DATASET_TARGET_Y,     // uint16
+    DATASET_STATUS,       // uint8, ShipState
+    DATASET_ACTION,       // uint8, DatasetAction
+    DATASET_HALITE_CROP,  // uint16 per crop cell
+    DATASET_FLAGS_CROP,   // uint8 per crop cell, DatasetCellFlag bits
+    DATASET_COLUMN_COUNT
+};
+
+// The command a ship got: 0-3 N, S, E, W (ALL_CARDINALS order), then
+enum DatasetAction : uint8_t {
+    DATASET_STILL = 4,
+    DATASET_CONSTRUCT = 5,
+    DATASET_NO_COMMAND = 255
+};
+
+enum DatasetCellFlag : uint8_t {
+    DATASET_INSPIRED = 1 << 0,
+    DATASET_ALLY = 1 << 1,      // one of our ships
+    DATASET_ENEMY = 1 << 2
+};
+
+struct DatasetGameHeader {
+    uint32_t version;
+    uint16_t width;
+    uint16_t height;
+    uint16_t my_id;
+    uint16_t num_players;
+    uint16_t radius;
+    uint16_t column_count;
+    uint32_t max_turns;
+};
+
+struct DatasetBatchHeader {
+    uint32_t turn;
+    uint32_t halite;   // Our bank
+    uint16_t rows;
+    uint16_t reserved;
+};
+
+static_assert(sizeof(DatasetGameHeader) == 20, "dataset layout");
+static_assert(sizeof(DatasetBatchHeader) == 12, "dataset layout");
+
+// Bytes per row of each column, for a crop of radius r
+inline size_t dataset_column_width(DatasetColumn column, int radius) {
+    size_t crop = static_cast<size_t>(2 * radius + 1) * (2 * radius + 1);
+    switch (column) {
+        case DATASET_SHIP_ID: return 4;
+        case DATASET_STATUS:
+        case DATASET_ACTION: return 1;
+        case DATASET_HALITE_CROP: return 2 * crop;
+        case DATASET_FLAGS_CROP: return crop;
+        default: return 2;
+    }
+}
+
+// Offset of every column from the end of the batch header, then the payload size at [DATASET_COLUMN_COUNT]
+inline array<size_t, DATASET_COLUMN_COUNT + 1> dataset_columns(int rows, int radius) {
+    array<size_t, DATASET_COLUMN_COUNT + 1> offsets;
+    size_t offset = 0;
+    for (int c = 0; c < DATASET_COLUMN_COUNT; ++c) {
+        offsets[c] = offset;
+        offset += (dataset_column_width(static_cast<DatasetColumn>(c), radius) * rows + 3) & ~static_cast<size_t>(3);
+    }
+    offsets[DATASET_COLUMN_COUNT] = offset;
+    return offsets;
+}
+
+// Encodes a batch per turn on the game thread (a few memcpy-sized loops per
+// ship) and appends it from the record writer's background thread.
+class DatasetWriter {
+public:
+    // Append to path and write the DSET record. Returns false if the file can't be opened.
+    bool open(const string& path, const Game& game, int radius, size_t ships);
+
+    // moves: (ship, direction) of the turn's move commands; constructs: ships turned into dropoffs
+    void write_turn(
+        const Game& game,
+        const ShipMemory& mem,
+        const vector<vector<bool>>& inspired,
+        const vector<pair<EntityId, Direction>>& moves,
+        const vector<EntityId>& constructs
+    );
+
+    int rows_written() const { return rows_written_; }
+
+private:
+    RecordFileWriter file_;
+    PolicyInputs inputs_;
+    vector<pair<EntityId, uint8_t>> actions_;   // by ship id, sorted
+    vector<const Ship*> ships_;
+    int rows_written_ = 0;
+};
@@ -0,0 +1,134 @@
+#include "bot_deposit_scheduler.hpp"
+
+#include <algorithm>
+
+// Deposits whose slots are allocated up front, so that building a dropoff does not allocate
+static const size_t RESERVED_DEPOSITS = 16;
+
+void DepositScheduler::begin_turn(const shared_ptr<Player>& me, GameMap* game_map_ptr, const ShipMemory& mem, int turns_remaining) {
+    turns_remaining_ = turns_remaining;
+
+    deposit_count_ = me->dropoffs.size() + 1;
+    int max_dist = game_map_ptr->width / 2 + game_map_ptr->height / 2 + 1;
+    if (deposits_.size() < std::max(deposit_count_, RESERVED_DEPOSITS)) {
+        deposits_.resize(std::max(deposit_count_, RESERVED_DEPOSITS));
+        for (auto& deposit : deposits_) deposit.last_arrival_closer.resize(max_dist + 2);
+    }
+
+    deposits_[0].position = me->shipyard->position;
+    size_t i = 1;
+    for (const auto& dropoff_entry : me->dropoffs) {
+        deposits_[i++].position = dropoff_entry.second->position;
+    }
+
+    for (size_t k = 0; k < deposit_count_; ++k) {
+        DepositSlots& deposit = deposits_[k];
+        deposit.arrivals.fill(0);
+        for (auto& lane : deposit.lane_arrivals) lane.fill(0);
+        std::fill(deposit.last_arrival_closer.begin(), deposit.last_arrival_closer.end(), 0);
+    }
+
+    // Counting sort of our returning ships by distance to their nearest deposit
+    for (const auto& ship_pair : me->ships) {
+        auto status = mem.ship_status.find(ship_pair.first);
+        if (status == mem.ship_status.end() || status->second != ShipState::RETURNING) continue;
+        int dist;
+        int k = nearest_deposit_index(ship_pair.second->position, game_map_ptr, dist);
+        if (dist > 0) deposits_[k].last_arrival_closer[dist]++;
+    }
+    // Nearest first, one arrival per turn: a ship lands at its distance or right after the one ahead of it
+    for (size_t k = 0; k < deposit_count_; ++k) {
+        vector<int>& queue = deposits_[k].last_arrival_closer;
+        int last_arrival = 0;
+        for (size_t d = 0; d < queue.size(); ++d) {
+            int ships = queue[d];
+            queue[d] = last_arrival;
+            if (ships > 0) last_arrival = std::max(static_cast<int>(d), last_arrival + 1) + ships - 1;
+        }
+    }
+}
+
+int DepositScheduler::nearest_deposit_index(const Position& from, GameMap* game_map_ptr, int& dist) const {
+    int best = 0;
+    dist = 9999;
+    for (size_t k = 0; k < deposit_count_; ++k) {
+        int d = game_map_ptr->calculate_distance(from, deposits_[k].position);
+        if (d < dist) {
+            dist = d;
+            best = static_cast<int>(k);
+        }
+    }
+    return best;
+}
+
+int DepositScheduler::turns_to_return(const Position& from, GameMap* game_map_ptr) const {
+    int dist;
+    int k = nearest_deposit_index(from, game_map_ptr, dist);
+
+    // Returning ships closer to the deposit land before us, one per turn
+    int arrival = dist > 0 ? std::max(dist, deposits_[k].last_arrival_closer[dist] + 1) : 0;
+    return arrival + ENDGAME_RECALL_MARGIN;
+}
+
+DepositBooking DepositScheduler::assign(const shared_ptr<Ship>& ship, GameMap* game_map_ptr) {
+    DepositBooking best;
+    int best_score = 99999;
+    int best_index = -1;
+    int best_lane = -1;
+    CellId here = game_map_ptr->cell_id(ship->position);
+
+    for (size_t k = 0; k < deposit_count_; ++k) {
+        const DepositSlots& deposit = deposits_[k];
+        int dist = game_map_ptr->calculate_distance(ship->position, deposit.position);
+
+        // Default plan: head straight in, no booking (too far away or already there)
+        int arrival = dist;
+        int lane_index = -1;
+
+        if (dist > 0 && dist < DEPOSIT_SCHEDULE_HORIZON && turns_remaining_ - dist > PILE_IN_SLACK) {
+            // Earliest turn at which both the deposit and one lane on a shortest path are free
+            for (int t = dist; t < DEPOSIT_SCHEDULE_HORIZON && lane_index < 0; ++t) {
+                if (deposit.arrivals[t] > 0) continue;
+
+                int fallback_lane = -1;
+                for (int l = 0; l < 4; ++l) {
+                    if (deposit.lane_arrivals[l][t - 1] > 0) continue;
+                    CellId lane = game_map_ptr->topology->neighbour(game_map_ptr->cell_id(deposit.position), l);
+                    if (game_map_ptr->calculate_distance(here, lane) == dist - 1) {
+                        lane_index = l;
+                        break;
+                    }
+                    if (fallback_lane < 0) fallback_lane = l;
+                }
+                if (lane_index < 0 && fallback_lane >= 0 && t >= dist + 2) {
+                    // A detour lane is dist + 1 away, so the earliest arrival through it is dist + 2
+                    lane_index = fallback_lane;
+                }
+                arrival = t;
+            }
+            if (lane_index < 0) arrival = DEPOSIT_SCHEDULE_HORIZON;
+        }
+
+        if (arrival < best_score) {
+            best_score = arrival;
+            best_index = static_cast<int>(k);
+            best_lane = lane_index;
+            best.deposit = deposit.position;
+            best.distance = dist;
+            best.arrival_turn = arrival;
+        }
+    }
+
+    best.lane = best.deposit;
+    best.pile_in = turns_remaining_ - best.distance <= PILE_IN_SLACK;
+
+    if (best_lane >= 0) {
+        DepositSlots& deposit = deposits_[best_index];
+        deposit.arrivals[best.arrival_turn]++;
+        deposit.lane_arrivals[best_lane][best.arrival_turn - 1]++;
+        best.lane = game_map_ptr->position(game_map_ptr->topology->neighbour(game_map_ptr->cell_id(best.deposit), best_lane));
+        best.hold = best.arrival_turn > best.distance && best.distance <= DEPOSIT_HOLD_DISTANCE;
+    }
+
+    return best;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+#include "bot_ship_memory.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Arrival plan of one returning ship for the current turn
+struct DepositBooking {
+    Position deposit;      // Deposit the ship is sequenced into
+    Position lane;         // Adjacent cell the ship enters the deposit from
+    int distance = 0;      // Current distance to the deposit
+    int arrival_turn = 0;  // Booked arrival, in turns from now (>= distance)
+    bool hold = false;     // Arriving now would jam the deposit: wait where we are
+    bool pile_in = false;  // Final turns: collide on purpose on our own deposit
+};
+
+// Hands out arrival slots (one ship per deposit per turn) and approach lanes
+// (one ship per lane cell per turn) over a short horizon. Slots are rebuilt
+// every turn so the cost is O(returning ships) per turn.
+class DepositScheduler {
+public:
+    void begin_turn(const shared_ptr<Player>& me, GameMap* game_map_ptr, const ShipMemory& mem, int turns_remaining);
+
+    // Book an arrival slot and a lane for a returning ship
+    DepositBooking assign(const shared_ptr<Ship>& ship, GameMap* game_map_ptr);
+
+    // Turns a ship needs to get its cargo home, including the queue of returning
+    // ships closer to the same deposit (they arrive one per turn, as assign books them)
+    int turns_to_return(const Position& from, GameMap* game_map_ptr) const;
+
+private:
+    struct DepositSlots {
+        Position position;
+        array<uint8_t, DEPOSIT_SCHEDULE_HORIZON> arrivals;
+        array<array<uint8_t, DEPOSIT_SCHEDULE_HORIZON>, 4> lane_arrivals;
+        vector<int> last_arrival_closer; // [d] = arrival turn of the last returning ship strictly closer than d, 0 if none
+    };
+
+    int nearest_deposit_index(const Position& from, GameMap* game_map_ptr, int& dist) const;
+
+    vector<DepositSlots> deposits_; // The first deposit_count_ are in use
+    size_t deposit_count_ = 0;
+    int turns_remaining_ = 0;
+};
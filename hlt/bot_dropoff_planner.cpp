@@ -1,15 +1,11 @@
 #include "bot_dropoff_planner.hpp"
 
+#include <algorithm>
+
 // Compute total halite in a square area around a position (used for dropoff placement)
-int count_halite_in_area(const Position& center, GameMap* game_map_ptr, int radius) {
-    int total_halite = 0;
-    for (int dy = -radius; dy <= radius; ++dy) {
-        for (int dx = -radius; dx <= radius; ++dx) {
-            Position pos = game_map_ptr->normalize(center + Position{ dx, dy });
-            total_halite += game_map_ptr->at(pos)->halite;
-        }
-    }
-    return total_halite;
+// The padded grid turns the wrapped square into contiguous row spans for the SIMD kernel
+int count_halite_in_area(const Position& center, const PaddedGrid& halite_grid, int radius) {
+    return static_cast<int>(simd_kernels().window_sum(halite_grid, center.x, center.y, radius));
 }
 
 // Compute total number of allied ships around a position
@@ -27,18 +23,17 @@ bool try_build_dropoff(
     const shared_ptr<Ship>& ship,
     const shared_ptr<Player>& me,
     GameMap* game_map_ptr,
+    const PaddedGrid& halite_grid,
+    const EconomyTracker& economy,
+    const TerritoryField* territory,
     int turns_remaining,
     vector<Command>& command_queue,
-    vector<vector<bool>>& next_turn_occupied
+    CellGrid<uint8_t>& next_turn_occupied
 ) {
-	// Dynamic timing: The larger the map, the more time we need to make it worth building a dropoff
-    int min_turns_for_roi = game_map_ptr->width * 2 + 20;
-
     // Dropoff construction logic
-    // Construction is considered only if we have the budget and enough time left
+    // Construction is considered only if we have the budget (whether enough time is left is part of the expected return)
     // Keeping a security margin (SHIP_COST) to be able to spawn after if needed
     if (me->halite >= DROPOFF_COST + constants::SHIP_COST &&
-        turns_remaining > min_turns_for_roi &&
         me->dropoffs.size() < MAX_DROPOFFS)
     {
         // Check 1 : Distance with the shipyard
@@ -46,8 +41,11 @@ bool try_build_dropoff(
 
         // Check 2 : Distance with other dropoffs
         bool too_close = false;
+        int nearest_deposit = dist_to_yard;
         for (const auto& dropoff : me->dropoffs) {
-            if (game_map_ptr->calculate_distance(ship->position, dropoff.second->position) < MIN_DIST_DROPOFF) {
+            int dist = game_map_ptr->calculate_distance(ship->position, dropoff.second->position);
+            nearest_deposit = std::min(nearest_deposit, dist);
+            if (dist < MIN_DIST_DROPOFF) {
                 too_close = true;
                 break;
             }
@@ -56,18 +54,28 @@ bool try_build_dropoff(
         // If we're far enough from existing structures and the cell doesn't already have a structure
         if (dist_to_yard >= MIN_DIST_DROPOFF && !too_close && !game_map_ptr->at(ship)->has_structure()) {
 
-            // Check 3 : Halite in the area (radius of 4)
-            int local_halite = count_halite_in_area(ship->position, game_map_ptr, 4);
+            // Check 3 : Halite in the area
+            int local_halite = count_halite_in_area(ship->position, halite_grid, DROPOFF_SCAN_RADIUS);
 
             // Requiring a minimum number of allied ships in the area to ensure the dropoff will be used
             int local_ships = count_allied_ships_in_area(ship->position, me, game_map_ptr, 5);
 
-            if (local_halite >= REQUIRED_HALITE_RADIUS && local_ships >= MIN_SHIPS_RADIUS) {
+            // Check 4 : Expected return (ships nearby stop commuting to the nearest deposit) against the actual cost
+            int build_cost = DROPOFF_COST - ship->halite - game_map_ptr->at(ship)->halite;
+            double expected_return = economy.dropoff_return(
+                turns_remaining, local_halite, local_ships, nearest_deposit - DROPOFF_SCAN_RADIUS / 2
+            );
+
+            // Check 5 : the area must be ours, or enemies would mine what the dropoff is built for
+            bool is_our_area = !territory || territory->share_in_square(ship->position, DROPOFF_SCAN_RADIUS) >= DROPOFF_MIN_TERRITORY;
+
+            if (expected_return >= build_cost * DROPOFF_MIN_RETURN && local_ships >= MIN_SHIPS_RADIUS && is_our_area) {
 				// Check if we're in the "center" of the rich area by comparing with adjacent cells
                 bool is_local_maximum = true;
+                CellId here = game_map_ptr->cell_id(ship->position);
                 for (const auto& dir : ALL_CARDINALS) {
-                    Position adj = game_map_ptr->normalize(ship->position.directional_offset(dir));
-                    int adj_halite = count_halite_in_area(adj, game_map_ptr, 4);
+                    Position adj = game_map_ptr->position(game_map_ptr->neighbour(here, dir));
+                    int adj_halite = count_halite_in_area(adj, halite_grid, DROPOFF_SCAN_RADIUS);
 
 					// If an adjacent cell has significantly more halite (e.g. +500), we're not on the best spot
                     if (adj_halite > local_halite + 500) {
@@ -5,12 +5,15 @@
 #include "log.hpp"
 
 #include "bot_config.hpp"
+#include "bot_economy.hpp"
+#include "bot_simd.hpp"
+#include "bot_territory.hpp"
 
 using namespace std;
 using namespace hlt;
 
 // Compute total halite in a square area around a position (used for dropoff placement)
-int count_halite_in_area(const Position& center, GameMap* game_map_ptr, int radius);
+int count_halite_in_area(const Position& center, const PaddedGrid& halite_grid, int radius);
 
 // Compute total number of allied ships around a position
 int count_allied_ships_in_area(
@@ -24,7 +27,10 @@ bool try_build_dropoff(
     const shared_ptr<Ship>& ship,
     const shared_ptr<Player>& me,
     GameMap* game_map_ptr,
+    const PaddedGrid& halite_grid,
+    const EconomyTracker& economy,
+    const TerritoryField* territory,
     int turns_remaining,
     vector<Command>& command_queue,
-    vector<vector<bool>>& next_turn_occupied
+    CellGrid<uint8_t>& next_turn_occupied
 );
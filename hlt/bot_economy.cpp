@@ -0,0 +1,108 @@
+#include "bot_economy.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void EconomyTracker::update(const Game& game) {
+    const GameMap& map = *game.game_map;
+
+    if (!initialized_) {
+        // Full scan once; every later turn only walks the engine deltas
+        initialized_ = true;
+        my_id_ = game.my_id;
+        width_ = map.width;
+        players_.assign(game.players.size(), PlayerEconomy());
+        mined_this_turn_.assign(game.players.size(), 0);
+        remaining_ = 0;
+        for (const MapCell& cell : map.cells) remaining_ += cell.halite;
+        double mean_halite = static_cast<double>(remaining_) / (map.width * map.height);
+        prior_ship_rate_ = mean_halite * ECONOMY_PRIOR_YIELD;
+    }
+    else {
+        vector<Halite>& mined = mined_this_turn_;
+        std::fill(mined.begin(), mined.end(), 0);
+        for (size_t i = 0; i < map.changed_cells.size(); ++i) {
+            const Position& p = map.changed_cells[i];
+            const MapCell& cell = map.cells[p.y][p.x];
+            Halite delta = cell.halite - map.changed_previous_halite[i];
+            remaining_ += delta;
+            if (delta < 0 && cell.ship) mined[cell.ship->owner] -= delta;
+        }
+
+        for (size_t id = 0; id < players_.size(); ++id) {
+            PlayerEconomy& economy = players_[id];
+            economy.mined_total += mined[id];
+            economy.income_rate = ECONOMY_RATE_DECAY * economy.income_rate + (1.0 - ECONOMY_RATE_DECAY) * mined[id];
+        }
+        mined_ = ECONOMY_RATE_DECAY * mined_ + mined[my_id_];
+    }
+
+    // Bank changes, corrected for what was spent on ships and dropoffs, are deposits
+    for (const auto& player : game.players) {
+        PlayerEconomy& economy = players_[player->id];
+
+        int new_ships = 0;
+        EntityId max_ship_id = economy.max_ship_id;
+        for (const auto& ship_iterator : player->ships) {
+            if (ship_iterator.first > economy.max_ship_id) ++new_ships;
+            max_ship_id = std::max(max_ship_id, ship_iterator.first);
+        }
+        size_t new_dropoffs = player->dropoffs.size() > economy.dropoffs ? player->dropoffs.size() - economy.dropoffs : 0;
+
+        Halite spent = new_ships * constants::SHIP_COST + static_cast<Halite>(new_dropoffs) * constants::DROPOFF_COST;
+        Halite deposited = std::max(0, player->halite - economy.last_bank + spent);
+
+        economy.last_bank = player->halite;
+        economy.max_ship_id = max_ship_id;
+        economy.dropoffs = player->dropoffs.size();
+
+        if (player->id == my_id_ && game.turn_number > 1) {
+            deposited_ = ECONOMY_RATE_DECAY * deposited_ + deposited;
+        }
+    }
+
+    ship_turns_ = ECONOMY_RATE_DECAY * ship_turns_ + game.me->ships.size();
+}
+
+double EconomyTracker::ship_deposit_rate() const {
+    // Deposits lag mining by a trip, so the observed rate is mining times the deposit efficiency
+    double efficiency = mined_ > 0.0 ? std::min(1.0, std::max(0.5, deposited_ / mined_)) : ECONOMY_PRIOR_EFFICIENCY;
+    double observed = mined_ * efficiency;
+    return (observed + prior_ship_rate_ * ECONOMY_PRIOR_SHIP_TURNS) / (ship_turns_ + ECONOMY_PRIOR_SHIP_TURNS);
+}
+
+double EconomyTracker::depletion_rate() const {
+    if (remaining_ <= 0) return 1.0;
+    double total_rate = 0.0;
+    for (const PlayerEconomy& economy : players_) total_rate += economy.income_rate;
+    return total_rate / static_cast<double>(remaining_);
+}
+
+double EconomyTracker::depleted_sum(double rate, int turns) const {
+    if (turns <= 0) return 0.0;
+    double k = depletion_rate();
+    if (k < 1e-6) return rate * turns;
+    return rate * (1.0 - std::exp(-k * turns)) / k;
+}
+
+double EconomyTracker::ship_return(int turns_remaining) const {
+    // A new ship first travels out, and its last cargo must be brought back in time
+    int productive_turns = turns_remaining - width_ / 2;
+    return depleted_sum(ship_deposit_rate(), productive_turns);
+}
+
+double EconomyTracker::dropoff_return(int turns_remaining, int local_halite, int local_ships, int distance_saved) const {
+    double rate = ship_deposit_rate();
+    if (rate <= 0.0 || distance_saved <= 0) return 0.0;
+
+    // A trip deposits ~cargo_per_trip over cargo_per_trip / rate turns; the dropoff cuts 2 * distance_saved of them
+    double cargo_per_trip = ECONOMY_CARGO_PER_TRIP * constants::MAX_HALITE;
+    double trip_turns = cargo_per_trip / rate;
+    double shorter_trip = std::max(1.0, trip_turns - 2.0 * distance_saved);
+    double gain_per_ship = cargo_per_trip / shorter_trip - rate;
+
+    double gain = depleted_sum(gain_per_ship * local_ships, turns_remaining - distance_saved);
+
+    // Ships can't bring back more than the area holds
+    return std::min(gain, static_cast<double>(local_halite));
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Game-wide halite accounting, updated from the engine deltas in O(changed cells + ships).
+//
+// Halite removed from a cell with a ship on it is attributed to that ship's
+// owner (ships only mine when they stay still). Income rates are exponential
+// moving averages over ECONOMY_RATE_DECAY. Our per-ship rate blends a prior
+// derived from the map with the observed rate, so estimates exist from turn 1.
+class EconomyTracker {
+public:
+    void update(const Game& game);
+
+    int64_t remaining_halite() const { return remaining_; }
+
+    // Halite mined per turn by a player (moving average) and since the start
+    double income_rate(PlayerId player) const { return players_[player].income_rate; }
+    int64_t mined_total(PlayerId player) const { return players_[player].mined_total; }
+
+    // Halite one of our ships deposits per turn (moving average, deposit losses included)
+    double ship_deposit_rate() const;
+
+    // Expected halite deposited over the remaining turns by one more ship
+    double ship_return(int turns_remaining) const;
+
+    // Expected extra halite deposited over the remaining turns thanks to a dropoff
+    // `distance_saved` turns closer to `local_ships` ships, capped by the halite around it
+    double dropoff_return(int turns_remaining, int local_halite, int local_ships, int distance_saved) const;
+
+private:
+    struct PlayerEconomy {
+        double income_rate = 0.0;
+        int64_t mined_total = 0;
+        Halite last_bank = 0;
+        EntityId max_ship_id = -1;
+        size_t dropoffs = 0;
+    };
+
+    // Fraction of the remaining map mined per turn by everyone
+    double depletion_rate() const;
+
+    // sum over t < turns of rate * e^(-depletion * t): income of a rate that shrinks with the map
+    double depleted_sum(double rate, int turns) const;
+
+    bool initialized_ = false;
+    PlayerId my_id_ = 0;
+    int width_ = 0;
+    int64_t remaining_ = 0;
+    double prior_ship_rate_ = 0.0;
+    vector<PlayerEconomy> players_;
+    vector<Halite> mined_this_turn_; // Scratch of update(), per player
+
+    // Decayed sums for our fleet
+    double ship_turns_ = 0.0;
+    double mined_ = 0.0;
+    double deposited_ = 0.0;
+};
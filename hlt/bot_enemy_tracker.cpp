@@ -0,0 +1,124 @@
+#include "bot_enemy_tracker.hpp"
+
+#include <algorithm>
+
+// Index of the move that brings `from` to `to` in one step on the torus (STILL if not adjacent)
+static int observed_move_index(const Position& from, const Position& to, GameMap* game_map_ptr) {
+    CellId from_cell = game_map_ptr->cell_id(from);
+    CellId to_cell = game_map_ptr->cell_id(to);
+    for (int k = 0; k < 4; ++k) {
+        if (game_map_ptr->topology->neighbour(from_cell, k) == to_cell) {
+            return k;
+        }
+    }
+    return ENEMY_MOVE_STILL;
+}
+
+const EnemyShipTrack* EnemyTracker::find(PlayerId owner, EntityId id) const {
+    auto it = tracks_.find(make_key(owner, id));
+    return it == tracks_.end() ? nullptr : &it->second;
+}
+
+void EnemyTracker::reserve(size_t ships) {
+    reserve_pooled(tracks_, ships);
+    // Every enemy stamps its cell and 4 neighbours
+    touched_cells_.reserve(ships * ENEMY_MOVE_KINDS);
+}
+
+void EnemyTracker::observe(EnemyShipTrack& track, const Ship& ship, GameMap* game_map_ptr, int turn) {
+    if (track.last_seen_turn < 0) {
+        // First sighting: uniform prior over the 5 moves
+        track.owner = ship.owner;
+        track.id = ship.id;
+        track.move_probability.fill(1.0 / ENEMY_MOVE_KINDS);
+        track.last_position = ship.position;
+        track.last_seen_turn = turn;
+        return;
+    }
+
+    int move = observed_move_index(track.last_position, ship.position, game_map_ptr);
+
+    // Exponential moving average of the observed moves
+    for (int k = 0; k < ENEMY_MOVE_KINDS; ++k) {
+        double hit = (k == move) ? 1.0 : 0.0;
+        track.move_probability[k] += ENEMY_MODEL_LEARNING_RATE * (hit - track.move_probability[k]);
+    }
+
+    track.last_position = ship.position;
+    track.last_seen_turn = turn;
+}
+
+void EnemyTracker::move_distribution(const Ship& ship, GameMap* game_map_ptr, array<double, ENEMY_MOVE_KINDS>& p) const {
+    // A ship that cannot pay the move cost is stuck on its cell this turn. The engine rounds the
+    // cost down; rounding up is only the safe side for our own ships, here it would hide moves
+    int origin_halite = game_map_ptr->at(ship.position)->halite;
+    int move_cost = origin_halite / constants::MOVE_COST_RATIO;
+    if (ship.halite < move_cost) {
+        p.fill(0.0);
+        p[ENEMY_MOVE_STILL] = 1.0;
+        return;
+    }
+
+    // Never let a direction drop to zero: the model is a guess, not a certainty
+    const EnemyShipTrack* track = find(ship.owner, ship.id);
+    double total = 0.0;
+    for (int k = 0; k < ENEMY_MOVE_KINDS; ++k) {
+        p[k] = track ? std::max(track->move_probability[k], ENEMY_MIN_MOVE_PROBABILITY) : 1.0;
+        total += p[k];
+    }
+    for (int k = 0; k < ENEMY_MOVE_KINDS; ++k) p[k] /= total;
+}
+
+void EnemyTracker::stamp_risk(CellId cell, float p) {
+    float& risk = risk_map_.at(cell);
+    if (risk == 0.0f) {
+        touched_cells_.push_back(cell);
+    }
+    // Independent ships: P(at least one arrives) = 1 - prod(1 - p_i)
+    risk = 1.0f - (1.0f - risk) * (1.0f - p);
+}
+
+void EnemyTracker::update(const Game& game) {
+    GameMap* game_map_ptr = game.game_map.get();
+
+    if (risk_map_.width() != game_map_ptr->width || risk_map_.height() != game_map_ptr->height) {
+        risk_map_.resize(game_map_ptr->width, game_map_ptr->height);
+        touched_cells_.clear();
+    }
+
+    // Clear only what was written last turn
+    for (CellId cell : touched_cells_) {
+        risk_map_.at(cell) = 0.0f;
+    }
+    touched_cells_.clear();
+
+    for (const auto& player_ptr : game.players) {
+        if (player_ptr->id == game.my_id) continue;
+
+        for (const auto& ship_pair : player_ptr->ships) {
+            const Ship& ship = *ship_pair.second;
+            EnemyShipTrack& track = tracks_[make_key(ship.owner, ship.id)];
+            observe(track, ship, game_map_ptr, game.turn_number);
+
+            array<double, ENEMY_MOVE_KINDS> p;
+            move_distribution(ship, game_map_ptr, p);
+            CellId here = game_map_ptr->cell_id(ship.position);
+            stamp_risk(here, static_cast<float>(p[ENEMY_MOVE_STILL]));
+            if (p[ENEMY_MOVE_STILL] == 1.0) continue;
+            for (int k = 0; k < 4; ++k) {
+                stamp_risk(game_map_ptr->topology->neighbour(here, k), static_cast<float>(p[k]));
+            }
+        }
+    }
+
+    // Forget ships that were not seen this turn (destroyed or turned into dropoffs),
+    // which keeps memory bounded by the live enemy fleet
+    for (auto it = tracks_.begin(); it != tracks_.end(); ) {
+        if (it->second.last_seen_turn != game.turn_number) {
+            it = tracks_.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+#include "fixed_containers.hpp"
+
+#include "bot_config.hpp"
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Move index used by the per-ship movement model (same order as ALL_CARDINALS, STILL last)
+static const int ENEMY_MOVE_KINDS = 5;
+static const int ENEMY_MOVE_STILL = 4;
+
+// What we remember about one enemy ship between turns
+struct EnemyShipTrack {
+    PlayerId owner = 0;
+    EntityId id = 0;
+
+    Position last_position;
+    int last_seen_turn = -1;    // -1 until the first sighting
+
+    // Running estimate of P(next move) for N, S, E, W, STILL
+    array<double, ENEMY_MOVE_KINDS> move_probability;
+};
+
+class EnemyTracker {
+public:
+    // Ingest the current frame: update tracks of every enemy ship, drop the dead ones,
+    // then rebuild the collision-risk grid. Costs O(enemy ships) once the grid is allocated.
+    void update(const Game& game);
+
+    // Probability (0..1) that an enemy ship occupies each cell next turn
+    const CellGrid<float>& risk_map() const { return risk_map_; }
+
+    // Pre-size the track table and risk bookkeeping for this many enemy ships
+    void reserve(size_t ships);
+
+    const EnemyShipTrack* find(PlayerId owner, EntityId id) const;
+
+    // P(next move) of an enemy ship for N, S, E, W, STILL (all on STILL when it cannot pay the move cost)
+    void move_distribution(const Ship& ship, GameMap* game_map_ptr, array<double, ENEMY_MOVE_KINDS>& p) const;
+    size_t tracked_count() const { return tracks_.size(); }
+
+private:
+    static uint64_t make_key(PlayerId owner, EntityId id) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(owner)) << 32) | static_cast<uint32_t>(id);
+    }
+
+    void observe(EnemyShipTrack& track, const Ship& ship, GameMap* game_map_ptr, int turn);
+    void stamp_risk(CellId cell, float p);
+
+    PooledMap<uint64_t, EnemyShipTrack> tracks_;
+
+    CellGrid<float> risk_map_;
+    // Cells written last turn, so the grid can be cleared without a full scan
+    vector<CellId> touched_cells_;
+};
@@ -0,0 +1,343 @@
+#include "bot_game_state.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+static const uint64_t BANK_KEY = 0xd6e8feb86659fd93ULL;
+
+static uint64_t splitmix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+void StateTileStore::reset(const StartupTables& tables) {
+    tables_ = &tables;
+    geometry_ = tables.geometry.get();
+
+    if (width_ != tables.width || height_ != tables.height) {
+        width_ = tables.width;
+        height_ = tables.height;
+        tiles_x_ = (width_ + STATE_TILE_SIZE - 1) >> STATE_TILE_SHIFT;
+        int tiles_y = (height_ + STATE_TILE_SIZE - 1) >> STATE_TILE_SHIFT;
+        tile_grid_size_ = tiles_x_ * tiles_y;
+
+        int cells = width_ * height_;
+        cell_slot_.resize(cells);
+        cell_key_.resize(cells);
+        occupant_.assign(cells, -1);
+        for (int y = 0; y < height_; ++y) {
+            for (int x = 0; x < width_; ++x) {
+                int tile = (y >> STATE_TILE_SHIFT) * tiles_x_ + (x >> STATE_TILE_SHIFT);
+                int offset = ((y & (STATE_TILE_SIZE - 1)) << STATE_TILE_SHIFT) | (x & (STATE_TILE_SIZE - 1));
+                cell_slot_[y * width_ + x] = (static_cast<uint32_t>(tile) << 6) | static_cast<uint32_t>(offset);
+                cell_key_[y * width_ + x] = splitmix64(static_cast<uint64_t>(y * width_ + x)) | 1;
+            }
+        }
+
+        // Room for a few clones of every tile before the store has to grow
+        halite_.resize(static_cast<size_t>(tile_grid_size_) * STATE_TILE_CELLS * 4);
+        tile_owner_.resize(static_cast<size_t>(tile_grid_size_) * 4);
+    }
+    tile_count_ = 0;
+}
+
+uint32_t StateTileStore::clone(uint32_t tile, uint32_t owner) {
+    if (tile_count_ == tile_owner_.size()) {
+        tile_owner_.resize(tile_owner_.size() * 2);
+        halite_.resize(halite_.size() * 2);
+    }
+    uint32_t copy = static_cast<uint32_t>(tile_count_++);
+    std::copy_n(&halite_[static_cast<size_t>(tile) << 6], STATE_TILE_CELLS, &halite_[static_cast<size_t>(copy) << 6]);
+    tile_owner_[copy] = owner;
+    return copy;
+}
+
+void GameState::load(const GameMap& game_map, const Player& me, const StartupTables& tables, StateTileStore& store) {
+    store.reset(tables);
+    store_ = &store;
+    owner_ = store.new_owner();
+    hash_ = 0;
+
+    // The root owns the first tile_grid_size_ tiles, in order
+    tiles_.resize(store.tile_grid_size_);
+    for (int t = 0; t < store.tile_grid_size_; ++t) {
+        tiles_[t] = static_cast<uint32_t>(t);
+        store.tile_owner_[t] = owner_;
+    }
+    store.tile_count_ = store.tile_grid_size_;
+    for (int y = 0; y < game_map.height; ++y) {
+        for (int x = 0; x < game_map.width; ++x) {
+            int cell = y * game_map.width + x;
+            int h = std::min(game_map.cells[y][x].halite, 65535);
+            uint32_t slot = store.cell_slot_[cell];
+            store.halite_[(static_cast<size_t>(tiles_[slot >> 6]) << 6) | (slot & 63)] = static_cast<uint16_t>(h);
+            hash_ += static_cast<uint64_t>(h) * store.cell_key_[cell];
+        }
+    }
+
+    ships_.clear();
+    for (const auto& ship_pair : me.ships) {
+        StateShip ship;
+        ship.id = ship_pair.second->id;
+        ship.cell = cell_index(ship_pair.second->position);
+        ship.halite = ship_pair.second->halite;
+        ships_.push_back(ship);
+    }
+    std::sort(ships_.begin(), ships_.end(), [](const StateShip& a, const StateShip& b) { return a.id < b.id; });
+    for (size_t i = 0; i < ships_.size(); ++i) hash_ += ship_term(static_cast<int>(i), ships_[i]);
+
+    // The first ships_.size() spare entries leave room for every ship becoming a dropoff
+    deposits_.resize(1 + me.dropoffs.size() + ships_.size());
+    deposit_count_ = 0;
+    deposits_[deposit_count_++] = cell_index(me.shipyard->position);
+    for (const auto& dropoff_pair : me.dropoffs) {
+        deposits_[deposit_count_++] = cell_index(dropoff_pair.second->position);
+    }
+    for (size_t i = 0; i < deposit_count_; ++i) hash_ += deposit_term(deposits_[i]);
+
+    bank_ = me.halite;
+    hash_ += static_cast<uint64_t>(bank_) * BANK_KEY;
+}
+
+void GameState::reserve(size_t ships) {
+    ships_.reserve(ships);
+    deposits_.reserve(2 * ships + 1);
+}
+
+void GameState::assign(const GameState& other) {
+    if (this == &other) return;
+    store_ = other.store_;
+    tiles_.assign(other.tiles_.begin(), other.tiles_.end());
+    ships_.assign(other.ships_.begin(), other.ships_.end());
+    deposits_.assign(other.deposits_.begin(), other.deposits_.end());
+    deposit_count_ = other.deposit_count_;
+    bank_ = other.bank_;
+    hash_ = other.hash_;
+
+    // Neither side may write the tiles they now share
+    owner_ = store_->new_owner();
+    other.owner_ = store_->new_owner();
+}
+
+int GameState::neighbour(int cell, Direction d) const {
+    return store_->geometry_->neighbour(static_cast<CellId>(cell), d);
+}
+
+int GameState::ship_slot(EntityId id) const {
+    auto it = std::lower_bound(ships_.begin(), ships_.end(), id, [](const StateShip& ship, EntityId value) { return ship.id < value; });
+    if (it == ships_.end() || it->id != id || !it->alive) return -1;
+    return static_cast<int>(it - ships_.begin());
+}
+
+bool GameState::is_deposit(int cell) const {
+    for (size_t i = 0; i < deposit_count_; ++i) {
+        if (deposits_[i] == cell) return true;
+    }
+    return false;
+}
+
+uint64_t GameState::ship_term(int slot, const StateShip& ship) const {
+    if (!ship.alive) return 0;
+    return splitmix64((static_cast<uint64_t>(slot) << 48) ^ (static_cast<uint64_t>(ship.cell) << 24) ^ static_cast<uint64_t>(ship.halite));
+}
+
+void GameState::write_halite(int cell, int value) {
+    uint32_t slot = store_->cell_slot_[cell];
+    uint32_t& tile = tiles_[slot >> 6];
+    if (store_->tile_owner_[tile] != owner_) tile = store_->clone(tile, owner_);
+    store_->halite_[(static_cast<size_t>(tile) << 6) | (slot & 63)] = static_cast<uint16_t>(value);
+}
+
+void GameState::set_halite(int cell, int value, StateUndo& undo) {
+    int before = halite(cell);
+    if (value == before) return;
+    value = std::min(value, 65535);
+    undo.cells.emplace_back(cell, static_cast<uint16_t>(before));
+    write_halite(cell, value);
+    hash_ += static_cast<uint64_t>(value - before) * store_->cell_key_[cell];
+}
+
+void GameState::set_ship(int slot, const StateShip& ship, StateUndo& undo) {
+    undo.ships.emplace_back(slot, ships_[slot]);
+    hash_ += ship_term(slot, ship) - ship_term(slot, ships_[slot]);
+    ships_[slot] = ship;
+}
+
+void GameState::set_bank(Halite bank) {
+    hash_ += static_cast<uint64_t>(bank - bank_) * BANK_KEY;
+    bank_ = bank;
+}
+
+void GameState::act(int slot, Direction move, StateUndo& undo) {
+    StateShip ship = ships_[slot];
+    if (!ship.alive) return;
+
+    int halite_here = halite(ship.cell);
+    bool moved = false;
+    if (move != Direction::STILL) {
+        int cost = halite_here / constants::MOVE_COST_RATIO;
+        if (ship.halite >= cost) {
+            ship.halite -= cost;
+            ship.cell = neighbour(ship.cell, move);
+            moved = true;
+        }
+    }
+    if (!moved) {
+        int mined = std::min(store_->tables_->extract(halite_here), constants::MAX_HALITE - ship.halite);
+        if (mined > 0) {
+            set_halite(ship.cell, halite_here - mined, undo);
+            ship.halite += mined;
+        }
+    }
+    if (ship.halite > 0 && is_deposit(ship.cell)) {
+        set_bank(bank_ + ship.halite);
+        ship.halite = 0;
+    }
+    set_ship(slot, ship, undo);
+}
+
+void GameState::step(const Direction* moves, StateUndo& undo) {
+    undo.clear();
+    undo.bank = bank_;
+    undo.hash = hash_;
+    undo.deposit_count = deposit_count_;
+
+    int count = static_cast<int>(ships_.size());
+    for (int i = 0; i < count; ++i) act(i, moves[i], undo);
+
+    // Ships sharing a cell sink: the cell is marked -2 when a second ship arrives
+    vector<int32_t>& occupant = store_->occupant_;
+    for (int i = 0; i < count; ++i) {
+        if (!ships_[i].alive) continue;
+        int32_t& o = occupant[ships_[i].cell];
+        o = (o == -1) ? i : -2;
+    }
+    for (int i = 0; i < count; ++i) {
+        if (!ships_[i].alive || occupant[ships_[i].cell] != -2) continue;
+        StateShip ship = ships_[i];
+        if (is_deposit(ship.cell)) set_bank(bank_ + ship.halite);
+        else set_halite(ship.cell, halite(ship.cell) + ship.halite, undo);
+        ship.halite = 0;
+        ship.alive = false;
+        set_ship(i, ship, undo);
+    }
+    for (int i = 0; i < count; ++i) occupant[ships_[i].cell] = -1;
+}
+
+void GameState::step_ship(int slot, Direction move, StateUndo& undo) {
+    undo.clear();
+    undo.bank = bank_;
+    undo.hash = hash_;
+    undo.deposit_count = deposit_count_;
+
+    act(slot, move, undo);
+}
+
+bool GameState::build_dropoff(int slot, StateUndo& undo) {
+    undo.clear();
+    undo.bank = bank_;
+    undo.hash = hash_;
+    undo.deposit_count = deposit_count_;
+
+    StateShip ship = ships_[slot];
+    if (!ship.alive || is_deposit(ship.cell)) return false;
+    int halite_here = halite(ship.cell);
+    if (bank_ + ship.halite + halite_here < constants::DROPOFF_COST) return false;
+
+    set_bank(bank_ + ship.halite + halite_here - constants::DROPOFF_COST);
+    set_halite(ship.cell, 0, undo);
+    ship.halite = 0;
+    ship.alive = false;
+    set_ship(slot, ship, undo);
+
+    if (deposit_count_ == deposits_.size()) deposits_.push_back(ship.cell);
+    else deposits_[deposit_count_] = ship.cell;
+    ++deposit_count_;
+    hash_ += deposit_term(ship.cell);
+    return true;
+}
+
+void GameState::undo(const StateUndo& undo) {
+    for (auto it = undo.cells.rbegin(); it != undo.cells.rend(); ++it) write_halite(it->first, it->second);
+    for (auto it = undo.ships.rbegin(); it != undo.ships.rend(); ++it) ships_[it->first] = it->second;
+    bank_ = undo.bank;
+    deposit_count_ = undo.deposit_count;
+    hash_ = undo.hash;
+}
+
+void ShipLookahead::reserve(size_t ships) {
+    state.reserve(ships);
+    undo_stack.resize(MAX_ROLLOUT_DEPTH);
+    for (auto& undo : undo_stack) undo.reserve(1);
+}
+
+int rollout_value(GameState& state, int slot, const Direction* plan, int depth, vector<StateUndo>& undo_stack) {
+    if (undo_stack.size() < static_cast<size_t>(depth)) undo_stack.resize(depth);
+
+    Halite bank_before = state.bank();
+    for (int i = 0; i < depth; ++i) state.step_ship(slot, plan[i], undo_stack[i]);
+    const StateShip& ship = state.ships()[slot];
+    int value = (ship.alive ? ship.halite : 0) + (state.bank() - bank_before);
+    for (int i = depth - 1; i >= 0; --i) state.undo(undo_stack[i]);
+    return value;
+}
+
+// Move along the axis with the longer wrapped distance to target
+static Direction step_toward(const Position& from, const Position& to, int width, int height) {
+    int dx = to.x - from.x;
+    int dy = to.y - from.y;
+    if (dx > width / 2) dx -= width;
+    else if (dx < -width / 2) dx += width;
+    if (dy > height / 2) dy -= height;
+    else if (dy < -height / 2) dy += height;
+
+    if (dx == 0 && dy == 0) return Direction::STILL;
+    if (std::abs(dx) >= std::abs(dy)) return dx > 0 ? Direction::EAST : Direction::WEST;
+    return dy > 0 ? Direction::SOUTH : Direction::NORTH;
+}
+
+Direction best_mining_plan_move(
+    GameState& state,
+    int slot,
+    const Position& target,
+    int depth,
+    vector<StateUndo>& undo_stack
+) {
+    depth = std::min(depth, MAX_ROLLOUT_DEPTH);
+
+    // Path to target, walked cell by cell on the torus
+    Direction path[MAX_ROLLOUT_DEPTH];
+    int path_length = 0;
+    int cell = state.ships()[slot].cell;
+    int target_cell = state.cell_index(target);
+    while (cell != target_cell && path_length < depth) {
+        Direction d = step_toward(state.cell_position(cell), target, state.width(), state.height());
+        path[path_length++] = d;
+        cell = state.neighbour(cell, d);
+    }
+    if (path_length == 0) return Direction::STILL;
+    // Too far to mine there within the horizon: nothing to compare
+    if (cell != target_cell || path_length == depth) return path[0];
+
+    // Plan j: stay j turns, walk the path, mine on the target until the horizon
+    Direction plan[MAX_ROLLOUT_DEPTH];
+    Direction best_move = path[0];
+    int best_value = -1;
+    for (int j = 0; j + path_length < depth; ++j) {
+        for (int i = 0; i < depth; ++i) {
+            plan[i] = (i >= j && i < j + path_length) ? path[i - j] : Direction::STILL;
+        }
+        int value = rollout_value(state, slot, plan, depth, undo_stack);
+        if (value > best_value) {
+            best_value = value;
+            best_move = plan[0];
+        }
+    }
+
+    // Staying for the whole horizon
+    std::fill(plan, plan + depth, Direction::STILL);
+    if (rollout_value(state, slot, plan, depth, undo_stack) > best_value) best_move = Direction::STILL;
+    return best_move;
+}
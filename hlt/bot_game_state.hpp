@@ -0,0 +1,188 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+#include "bot_precompute.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Halite values are stored in square tiles of STATE_TILE_SIZE x STATE_TILE_SIZE cells
+static const int STATE_TILE_SHIFT = 3;
+static const int STATE_TILE_SIZE = 1 << STATE_TILE_SHIFT;
+static const int STATE_TILE_CELLS = STATE_TILE_SIZE * STATE_TILE_SIZE;
+
+// Storage of the halite tiles shared by the GameStates of one turn.
+//
+// A state only holds the index of each of its tiles. Copying a state copies
+// those indices, and the first write to a tile the state does not own clones
+// it here, so a snapshot costs O(tiles) and a move touches one tile.
+// GameState::load reuses the whole store, so states must not outlive their turn;
+// mark() / release() free the tiles cloned by a finished branch of a search.
+class StateTileStore {
+public:
+    size_t mark() const { return tile_count_; }
+    void release(size_t mark) { tile_count_ = mark; }
+
+    size_t tile_count() const { return tile_count_; }
+
+private:
+    friend class GameState;
+
+    void reset(const StartupTables& tables);
+    uint32_t new_owner() { return ++last_owner_; }
+    uint32_t clone(uint32_t tile, uint32_t owner);
+
+    int width_ = 0;
+    int height_ = 0;
+    int tiles_x_ = 0;
+    int tile_grid_size_ = 0;
+
+    vector<uint16_t> halite_;      // STATE_TILE_CELLS values per tile
+    vector<uint32_t> tile_owner_;  // state allowed to write the tile in place
+    size_t tile_count_ = 0;
+    uint32_t last_owner_ = 0;
+
+    vector<uint32_t> cell_slot_;   // (tile position << 6) | offset in the tile, per cell
+    vector<uint64_t> cell_key_;    // Hash key of each cell
+    const CellTopology* geometry_ = nullptr;
+    const StartupTables* tables_ = nullptr;
+
+    vector<int32_t> occupant_;     // Ship slot on each cell during step() collisions, -1 if none
+};
+
+// One of our ships inside a GameState
+struct StateShip {
+    EntityId id = -1;
+    int cell = 0;
+    Halite halite = 0;
+    bool alive = true;
+};
+
+// What a step changed, so undo() restores the state exactly.
+// Records keep their capacity, so a search reusing them does not allocate.
+struct StateUndo {
+    vector<pair<int32_t, uint16_t>> cells;  // (cell, halite before)
+    vector<pair<int32_t, StateShip>> ships; // (slot, ship before)
+    Halite bank = 0;
+    uint64_t hash = 0;
+    size_t deposit_count = 0;
+
+    void clear() { cells.clear(); ships.clear(); }
+    // A fleet step changes at most one cell and one ship record per ship, plus a ship per collision
+    void reserve(size_t ships_count) { cells.reserve(2 * ships_count); ships.reserve(2 * ships_count); }
+};
+
+// Compact state of the game for lookahead: map halite, our ships, bank and deposits.
+//
+// The forward model applies the engine rules to our ships only: a move costs
+// floor(cell / MOVE_COST_RATIO) and a ship that cannot pay stays, a ship that
+// stays mines ceil(cell / EXTRACT_RATIO) up to its free capacity, a ship ending
+// its turn on a deposit unloads into the bank, and ships ending on the same cell
+// are destroyed with their cargo dropped on it (or banked, on a deposit).
+// Enemies and inspiration are not modelled.
+//
+// hash() is maintained incrementally (cells, ships, bank and deposits are
+// additive terms), so repeated states can be detected in O(1).
+class GameState {
+public:
+    GameState() = default;
+    GameState(const GameState& other) { assign(other); }
+    GameState& operator=(const GameState& other) { assign(other); return *this; }
+
+    // Root state of this turn for player me; reuses store (every state of the previous turn becomes invalid)
+    void load(const GameMap& game_map, const Player& me, const StartupTables& tables, StateTileStore& store);
+
+    // Room for this many ships (and as many dropoffs), so load() does not allocate as the fleet grows
+    void reserve(size_t ships);
+
+    // Become a snapshot of other. Shared tiles become copy-on-write for both states.
+    void assign(const GameState& other);
+
+    int width() const { return store_->width_; }
+    int height() const { return store_->height_; }
+    int cell_index(const Position& p) const { return p.y * store_->width_ + p.x; }
+    Position cell_position(int cell) const { return Position(cell % store_->width_, cell / store_->width_); }
+    int neighbour(int cell, Direction d) const;
+
+    int halite(int cell) const {
+        uint32_t slot = store_->cell_slot_[cell];
+        return store_->halite_[(static_cast<size_t>(tiles_[slot >> 6]) << 6) | (slot & 63)];
+    }
+    int halite(const Position& p) const { return halite(cell_index(p)); }
+
+    const vector<StateShip>& ships() const { return ships_; }
+    // Slot of a ship in ships(), -1 if it is not ours or no longer alive
+    int ship_slot(EntityId id) const;
+
+    Halite bank() const { return bank_; }
+    bool is_deposit(int cell) const;
+    uint64_t hash() const { return hash_; }
+
+    // One turn for the whole fleet, moves[i] being the move of ships()[i] (dead ships ignored)
+    void step(const Direction* moves, StateUndo& undo);
+
+    // One turn in which only ships()[slot] acts; the rest of the fleet neither moves nor mines
+    // and is not collided with (it would have moved out of the way in the real game)
+    void step_ship(int slot, Direction move, StateUndo& undo);
+
+    // Turn ships()[slot] into a dropoff if the bank covers the cost (less its cargo and the cell's halite)
+    bool build_dropoff(int slot, StateUndo& undo);
+
+    // Revert the step recorded in undo (steps are undone in reverse order)
+    void undo(const StateUndo& undo);
+
+private:
+    void set_halite(int cell, int value, StateUndo& undo);
+    void set_ship(int slot, const StateShip& ship, StateUndo& undo);
+    void set_bank(Halite bank);
+    void write_halite(int cell, int value);
+
+    // Mine, unload or move one ship (collisions are handled by the caller)
+    void act(int slot, Direction move, StateUndo& undo);
+
+    uint64_t ship_term(int slot, const StateShip& ship) const;
+    uint64_t deposit_term(int cell) const { return store_->cell_key_[cell] * 0x9e3779b97f4a7c15ULL; }
+
+    StateTileStore* store_ = nullptr;
+    // Taking a snapshot of a state also makes its own tiles copy-on-write, hence mutable
+    mutable uint32_t owner_ = 0;
+    vector<uint32_t> tiles_;
+    vector<StateShip> ships_;
+    vector<int> deposits_;
+    size_t deposit_count_ = 0;
+    Halite bank_ = 0;
+    uint64_t hash_ = 0;
+};
+
+// Longest plan the rollout helpers evaluate
+static const int MAX_ROLLOUT_DEPTH = 32;
+
+// Root state of the turn and the buffers of the rollouts run from it
+struct ShipLookahead {
+    StateTileStore tiles;
+    GameState state;
+    vector<StateUndo> undo_stack;
+
+    void reserve(size_t ships);
+};
+
+// Cargo plus banked halite of ships()[slot] after following plan[0 .. depth)
+int rollout_value(GameState& state, int slot, const Direction* plan, int depth, vector<StateUndo>& undo_stack);
+
+// Mine-here versus go-to-target: compares staying j turns then walking the
+// path to target (j = 0 .. depth) by their value after depth turns,
+// and returns the first move of the best plan
+Direction best_mining_plan_move(
+    GameState& state,
+    int slot,
+    const Position& target,
+    int depth,
+    vector<StateUndo>& undo_stack
+);
@@ -63,8 +63,11 @@ Direction decide_mining_direction(
     const shared_ptr<Ship>& ship,
     GameMap* game_map_ptr,
     ShipMemory& mem,
-    const vector<vector<bool>>& next_turn_occupied,
-    const vector<vector<bool>>& danger_map,
+    MiningGrids& mining_grids,
+    const AttractionField& attraction,
+    ShipLookahead* lookahead,
+    const CellGrid<uint8_t>& next_turn_occupied,
+    const CellGrid<float>& risk_map,
     const vector<vector<bool>>& inspired,
     vector<vector<bool>>& claimed_targets
 ) {
@@ -86,9 +89,29 @@ Direction decide_mining_direction(
 
     // If target reached or became poor, choose a new one
     if (ship->position == current_target || target_halite_raw < MIN_TARGET_HALITE) {
-        mem.ship_target[ship->id] = pick_mining_target(ship->position, game_map_ptr, inspired, claimed_targets);
-        current_target = mem.ship_target[ship->id];
+        // Equivalent of pick_mining_target on the fixed-point SIMD scan
+        current_target = scan_mining_window(simd_kernels(), mining_grids, ship->position);
+
+        // Nothing worth mining in the window: head for the peak of the attraction field instead,
+        // which senses rich regions beyond SEARCH_RADIUS
+        if (USE_ATTRACTION_FIELD && game_map_ptr->at(current_target)->halite < MIN_TARGET_HALITE) {
+            Position peak = attraction.best_peak(ship->position);
+            if (peak != ship->position && !claimed_targets[peak.y][peak.x]) {
+                current_target = peak;
+            }
+        }
+        claimed_targets[current_target.y][current_target.x] = true;
+        mining_grids.claim(current_target);
+        mem.ship_target[ship->id] = current_target;
+    }
+
+    // Leaving is only worth it if the target pays for the trip within the rollout horizon
+    if (lookahead) {
+        int slot = lookahead->state.ship_slot(ship->id);
+        if (slot >= 0 && best_mining_plan_move(lookahead->state, slot, current_target, ROLLOUT_DEPTH, lookahead->undo_stack) == Direction::STILL) {
+            return Direction::STILL;
+        }
     }
 
-    return smart_navigate(ship, game_map_ptr, current_target, next_turn_occupied, danger_map);
+    return smart_navigate(ship, game_map_ptr, current_target, next_turn_occupied, risk_map);
 }
@@ -3,8 +3,11 @@
 #include "game.hpp"
 #include "constants.hpp"
 #include "log.hpp"
+#include "bot_attraction_field.hpp"
 #include "bot_ship_memory.hpp"
 #include "bot_config.hpp"
+#include "bot_game_state.hpp"
+#include "bot_simd.hpp"
 
 using namespace std;
 using namespace hlt;
@@ -25,8 +28,11 @@ Direction decide_mining_direction(
     const shared_ptr<Ship>& ship,
     GameMap* game_map_ptr,
     ShipMemory& mem,
-    const vector<vector<bool>>& next_turn_occupied,
-    const vector<vector<bool>>& danger_map,
+    MiningGrids& mining_grids,
+    const AttractionField& attraction,
+    ShipLookahead* lookahead,
+    const CellGrid<uint8_t>& next_turn_occupied,
+    const CellGrid<float>& risk_map,
     const vector<vector<bool>>& inspired,
     vector<vector<bool>>& claimed_targets
 );
@@ -1,31 +1,37 @@
 #include "bot_navigation.hpp"
 
+#include <limits>
+
 Direction smart_navigate(
     const shared_ptr<Ship>& ship,
     GameMap* game_map_ptr,
     const Position& target,
-    const vector<vector<bool>>& next_turn_occupied,
-    const vector<vector<bool>>& danger_map
+    const CellGrid<uint8_t>& next_turn_occupied,
+    const CellGrid<float>& risk_map
 ) {
     // already on the target
     if (ship->position == target) return Direction::STILL;
 
+    // Neighbours, distances and grid reads below are table lookups on cell ids
+    CellId here = game_map_ptr->cell_id(ship->position);
+    CellId goal = game_map_ptr->cell_id(target);
+
     // Obtain the "ideal" directions (the shortest one towards the target)
     // get_unsafe_moves gives 1 or 2 directions (e.g. North and East)
-    vector<Direction> unsafe_moves = game_map_ptr->get_unsafe_moves(ship->position, target);
+    FixedVector<Direction, 2> unsafe_moves = game_map_ptr->get_unsafe_moves(ship->position, target);
 
 
     // Try ideal directions first
     // UPGRADE?: move pre-pass here if possible
     for (const auto& dir : unsafe_moves) {
-        Position candidate = game_map_ptr->normalize(ship->position.directional_offset(dir));
+        CellId candidate = game_map_ptr->neighbour(here, dir);
 
 		// Exception: if the targeted cell is our target dropoff, we go there even if it's dangerous
-        bool is_danger = danger_map[candidate.y][candidate.x] && (candidate != target);
+        bool is_danger = is_dangerous(risk_map, candidate) && (candidate != goal);
 
 		// Cell is either free or occupied by an allied ship that will move
         // = safe to move there due to pre-pass marking
-        if (!next_turn_occupied[candidate.y][candidate.x] && !is_danger) {
+        if (!next_turn_occupied.at(candidate) && !is_danger) {
             return dir;
         }
     }
@@ -33,23 +39,27 @@ Direction smart_navigate(
     // If ideal directions are blocked, look for an alternative
     // search for an adjacent free cell that doesn't take us too far away
     Direction best_alternative = Direction::STILL;
-    int shortest_dist = game_map_ptr->calculate_distance(ship->position, target);
+    int shortest_dist = game_map_ptr->calculate_distance(here, goal);
     int best_dist = 9999;
+    float best_risk = 1.0f;
 
     for (const auto& dir : ALL_CARDINALS) {
-        Position candidate = game_map_ptr->normalize(ship->position.directional_offset(dir));
-        bool is_danger = danger_map[candidate.y][candidate.x] && (candidate != target);
+        CellId candidate = game_map_ptr->neighbour(here, dir);
+        bool is_danger = is_dangerous(risk_map, candidate) && (candidate != goal);
 
         // skip if already taken
-        if (!next_turn_occupied[candidate.y][candidate.x] && !is_danger)
+        if (!next_turn_occupied.at(candidate) && !is_danger)
         {
             // compute distance via this alternative cell
-            int dist = game_map_ptr->calculate_distance(candidate, target);
+            int dist = game_map_ptr->calculate_distance(candidate, goal);
 
             // Accept moving slightly away if it's the only option to move
             // UPGRADE: adapt to change with `dist < shortest_dist` but needs testing
-            if (dist < best_dist) {
+            // Equal distance: prefer the cell with the lower collision risk
+            float risk = risk_map.at(candidate);
+            if (dist < best_dist || (dist == best_dist && risk < best_risk)) {
                 best_dist = dist;
+                best_risk = risk;
                 best_alternative = dir;
             }
         }
@@ -61,7 +71,7 @@ Direction smart_navigate(
 
     // Danger map logic
     // are we currently safe?
-    bool is_here_safe = !danger_map[ship->position.y][ship->position.x];
+    bool is_here_safe = !is_dangerous(risk_map, here);
 
     if (is_here_safe) {
         // Better to wait than to take a risky move
@@ -69,19 +79,26 @@ Direction smart_navigate(
     }
 
 	// If we're already in danger, we need to run towards the target ignoring the danger map (but still avoiding occupied allies' cells)
+    // Only take an ideal direction if it is not riskier than staying here
+    float risk_here = risk_map.at(here);
     for (const auto& dir : unsafe_moves) {
-        Position candidate = game_map_ptr->normalize(ship->position.directional_offset(dir));
-        if (!next_turn_occupied[candidate.y][candidate.x]) return dir;
+        CellId candidate = game_map_ptr->neighbour(here, dir);
+        if (!next_turn_occupied.at(candidate) && risk_map.at(candidate) <= risk_here) return dir;
     }
 
+    // Above any risk, so the first free neighbour is always taken
     int best_panic_dist = 9999;
+    float best_panic_risk = std::numeric_limits<float>::infinity();
     Direction best_panic_dir = Direction::STILL;
     for (const auto& dir : ALL_CARDINALS) {
-        Position candidate = game_map_ptr->normalize(ship->position.directional_offset(dir));
-        if (!next_turn_occupied[candidate.y][candidate.x]) {
-            int dist = game_map_ptr->calculate_distance(candidate, target);
-            if (dist < best_panic_dist) {
+        CellId candidate = game_map_ptr->neighbour(here, dir);
+        if (!next_turn_occupied.at(candidate)) {
+            int dist = game_map_ptr->calculate_distance(candidate, goal);
+            float risk = risk_map.at(candidate);
+            // Least risky escape first, then closest to the target
+            if (risk < best_panic_risk || (risk == best_panic_risk && dist < best_panic_dist)) {
                 best_panic_dist = dist;
+                best_panic_risk = risk;
                 best_panic_dir = dir;
             }
         }
@@ -125,15 +142,17 @@ void update_ship_state(
     const shared_ptr<Player>& me,
     GameMap* game_map_ptr,
     int turns_remaining,
+    const DepositScheduler& scheduler,
+    const TerritoryField* territory,
     ShipMemory& mem
 ) {
     EntityId id = ship->id;
 
     // Endgame recall: force returning when remaining turns are low
     Position nearest_deposit_pos = get_nearest_deposit_position(me, game_map_ptr, ship->position);
-    int dist_to_deposit = game_map_ptr->calculate_distance(ship->position, nearest_deposit_pos);
 
-    if (turns_remaining < dist_to_deposit + 10) { // 10 is a safety margin
+    // Budget includes the queue of closer ships draining into the same deposit
+    if (turns_remaining < scheduler.turns_to_return(ship->position, game_map_ptr)) {
         mem.ship_status[id] = ShipState::RETURNING;
     }
 
@@ -153,47 +172,66 @@ void update_ship_state(
             // If we're 95% full, we return to the shipyard to deposit
             mem.ship_status[id] = ShipState::RETURNING;
         }
+        else if (territory && ship->halite >= constants::MAX_HALITE * RETREAT_CARGO_FRACTION &&
+                 territory->enemy_distance(ship->position) <= RETREAT_ENEMY_DISTANCE) {
+            // Loaded and an enemy is close: bank the cargo before it can be rammed
+            mem.ship_status[id] = ShipState::RETURNING;
+        }
     }
 }
 
 Direction decide_returning_direction(
     const shared_ptr<Ship>& ship,
-    const shared_ptr<Player>& me,
+    const DepositBooking& booking,
     GameMap* game_map_ptr,
-    const vector<vector<bool>>& next_turn_occupied,
-    const vector<vector<bool>>& danger_map,
+    const CellGrid<uint8_t>& next_turn_occupied,
+    const CellGrid<float>& risk_map,
     bool is_inspired
 ) {
     // Moving logic based on state
-    Position nearest_deposit_pos = get_nearest_deposit_position(me, game_map_ptr, ship->position);
+    Position deposit_pos = booking.deposit;
 
     // If we are on the deposit, move out to free it.
     // Prefer the adjacent free cell with the lowest halite to avoid getting stuck at 0 cargo.
-    if (ship->position == nearest_deposit_pos) {
-        Position best_exit = nearest_deposit_pos;
+    if (ship->position == deposit_pos) {
+        CellId deposit = game_map_ptr->cell_id(deposit_pos);
+        CellId best_exit = deposit;
         int best_halite = 999999;
         bool found = false;
 
         // Looking for cheapest exit
         for (const auto& dir : ALL_CARDINALS) {
-            Position p = game_map_ptr->normalize(nearest_deposit_pos.directional_offset(dir));
-            if (next_turn_occupied[p.y][p.x]) continue;
+            CellId exit = game_map_ptr->neighbour(deposit, dir);
+            if (next_turn_occupied.at(exit)) continue;
 
-            int h = game_map_ptr->at(p)->halite;
+            int h = game_map_ptr->at(exit)->halite;
             if (h < best_halite) {
                 best_halite = h;
-                best_exit = p;
+                best_exit = exit;
                 found = true;
             }
         }
         if (found) {
             // Using smart_navigate towards the best exit
-            return smart_navigate(ship, game_map_ptr, best_exit, next_turn_occupied, danger_map);
+            return smart_navigate(ship, game_map_ptr, game_map_ptr->position(best_exit), next_turn_occupied, risk_map);
         }
         return Direction::STILL;
     }
 
-    return smart_navigate(ship, game_map_ptr, nearest_deposit_pos, next_turn_occupied, danger_map);
+    // Final turns: step onto our own deposit even if an ally is landing there too
+    // (the engine deposits the cargo of every ship colliding on it)
+    if (booking.pile_in && booking.distance == 1) {
+        return game_map_ptr->get_unsafe_moves(ship->position, deposit_pos).front();
+    }
+
+    // Our arrival slot is later than our distance: wait here instead of queueing next to the deposit
+    if (booking.hold && !is_dangerous(risk_map, game_map_ptr->cell_id(ship->position))) {
+        return Direction::STILL;
+    }
+
+    // Approach through the booked lane, then step in
+    Position waypoint = (booking.lane == ship->position || booking.pile_in) ? deposit_pos : booking.lane;
+    return smart_navigate(ship, game_map_ptr, waypoint, next_turn_occupied, risk_map);
 }
 
 
@@ -218,37 +256,58 @@ Direction apply_move_cost_safety(
     return intended_direction;
 }
 
-Command finalize_and_reserve_move(
+Direction finalize_and_reserve_move(
     const shared_ptr<Ship>& ship,
     GameMap* game_map_ptr,
     Direction intended_direction,
-    vector<vector<bool>>& next_turn_occupied
+    CellGrid<uint8_t>& next_turn_occupied,
+    FleetTelemetry* telemetry
 ) {
     // Add collision avoidance between our own ships (reserve destinations each turn)
-    Command final_command = ship->stay_still(); // Don't move by default (in case we need to stay still due to collisions)
-    Position final_target = ship->position;     // Target position we intend to move to (initially our current position)
+    CellId here = game_map_ptr->cell_id(ship->position);
+    Direction final_direction = Direction::STILL; // Don't move by default (in case we need to stay still due to collisions)
+    CellId final_target = here;                   // Cell we intend to move to (initially our current cell)
 
-    // Checking the intended move's target position, if it's occupied, we stay still
+    // Checking the intended move's target cell, if it's occupied, we stay still
     // UPGRADE: Checking adjacent cells for an alternative move
 
-    Position target_pos = game_map_ptr->normalize(ship->position.directional_offset(intended_direction));
+    CellId target = game_map_ptr->neighbour(here, intended_direction);
 
     // If cell is free in the next turn, we can move there
-    if (!next_turn_occupied[target_pos.y][target_pos.x]) {
-        final_command = ship->move(intended_direction);
-        final_target = target_pos;
+    if (!next_turn_occupied.at(target)) {
+        final_direction = intended_direction;
+        final_target = target;
     }
     else {
         // Otherwise, we stay still to avoid collision
         // BUT if we stay still, we need to make sure to mark our current position as occupied
         // Since every ship move in order, if we stay still, we will occupy our current cell in the next turn
         // So it should be safe
-        final_command = ship->stay_still();
-        final_target = ship->position;
+        final_direction = Direction::STILL;
+        final_target = here;
+        if (telemetry && intended_direction != Direction::STILL) telemetry->count_blocked(ship->id);
     }
 
-    // Marking the final target position as occupied
-    next_turn_occupied[final_target.y][final_target.x] = true;
+    // Marking the final target cell as occupied
+    next_turn_occupied.at(final_target) = true;
+
+    return final_direction;
+}
+
+Direction finalize_pile_in_move(
+    const shared_ptr<Ship>& ship,
+    GameMap* game_map_ptr,
+    Direction intended_direction,
+    const Position& deposit,
+    CellGrid<uint8_t>& next_turn_occupied,
+    FleetTelemetry* telemetry
+) {
+    // Stacking on our own deposit is allowed, every other cell still goes through the reservation
+    CellId target = game_map_ptr->neighbour(game_map_ptr->cell_id(ship->position), intended_direction);
+    if (target == game_map_ptr->cell_id(deposit)) {
+        next_turn_occupied.at(target) = true;
+        return intended_direction;
+    }
 
-    return final_command;
+    return finalize_and_reserve_move(ship, game_map_ptr, intended_direction, next_turn_occupied, telemetry);
 }
@@ -4,17 +4,26 @@
 #include "constants.hpp"
 #include "log.hpp"
 
+#include "bot_config.hpp"
+#include "bot_deposit_scheduler.hpp"
 #include "bot_ship_memory.hpp"
+#include "bot_telemetry.hpp"
+#include "bot_territory.hpp"
 
 using namespace std;
 using namespace hlt;
 
+// True if the collision risk on a cell is too high to step on it voluntarily
+inline bool is_dangerous(const CellGrid<float>& risk_map, CellId cell) {
+    return risk_map.at(cell) > DANGER_RISK_THRESHOLD;
+}
+
 Direction smart_navigate(
     const shared_ptr<Ship>& ship,
     GameMap* game_map_ptr,
     const Position& target,
-    const vector<vector<bool>>& next_turn_occupied,
-    const vector<vector<bool>>& danger_map
+    const CellGrid<uint8_t>& next_turn_occupied,
+    const CellGrid<float>& risk_map
 );
 
 Position get_nearest_deposit_position(
@@ -28,15 +37,17 @@ void update_ship_state(
     const shared_ptr<Player>& me,
     GameMap* game_map_ptr,
     int turns_remaining,
+    const DepositScheduler& scheduler,
+    const TerritoryField* territory,
     ShipMemory& mem
 );
 
 Direction decide_returning_direction(
     const shared_ptr<Ship>& ship,
-    const shared_ptr<Player>& me,
+    const DepositBooking& booking,
     GameMap* game_map_ptr,
-    const vector<vector<bool>>& next_turn_occupied,
-    const vector<vector<bool>>& danger_map,
+    const CellGrid<uint8_t>& next_turn_occupied,
+    const CellGrid<float>& risk_map,
     bool is_inspired
 );
 
@@ -46,9 +57,22 @@ Direction apply_move_cost_safety(
     Direction intended_direction
 );
 
-Command finalize_and_reserve_move(
+// Reserves the ship's destination and returns the move it makes: intended_direction, or STILL
+// when that cell is taken. Moves cancelled by a reservation are counted as blocked in telemetry (if not null)
+Direction finalize_and_reserve_move(
+    const shared_ptr<Ship>& ship,
+    GameMap* game_map_ptr,
+    Direction intended_direction,
+    CellGrid<uint8_t>& next_turn_occupied,
+    FleetTelemetry* telemetry
+);
+
+// Like finalize_and_reserve_move, but lets the ship land on an already reserved deposit (endgame pile-in)
+Direction finalize_pile_in_move(
     const shared_ptr<Ship>& ship,
     GameMap* game_map_ptr,
     Direction intended_direction,
-    vector<vector<bool>>& next_turn_occupied
+    const Position& deposit,
+    CellGrid<uint8_t>& next_turn_occupied,
+    FleetTelemetry* telemetry
 );
@@ -0,0 +1,164 @@
+#include "bot_policy.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+using Clock = std::chrono::steady_clock;
+
+// Largest window a weights file may ask for
+static const int POLICY_MAX_RADIUS = 16;
+
+void PolicyInputs::prepare(const Game& game) {
+    const GameMap& game_map = *game.game_map;
+    width_ = game_map.width;
+    occupant_.assign(static_cast<size_t>(game_map.width) * game_map.height, EMPTY);
+    for (const auto& player_ptr : game.players) {
+        uint8_t mark = player_ptr->id == game.my_id ? ALLY : ENEMY;
+        for (const auto& ship_pair : player_ptr->ships) {
+            const Position& p = ship_pair.second->position;
+            occupant_[p.y * width_ + p.x] = mark;
+        }
+    }
+}
+
+void PolicyInputs::features(const Game& game, const Ship& ship, float* out) const {
+    int side = 2 * radius_ + 1;
+    int plane = side * side;
+    float halite_scale = 1.0f / constants::MAX_HALITE;
+
+    float* halite = out + POLICY_HALITE * plane;
+    float* ally = out + POLICY_ALLY * plane;
+    float* enemy = out + POLICY_ENEMY * plane;
+    crop(game, ship, [&](int i, const MapCell& cell, Occupant occupant) {
+        halite[i] = cell.halite * halite_scale;
+        ally[i] = occupant == ALLY ? 1.0f : 0.0f;
+        enemy[i] = occupant == ENEMY ? 1.0f : 0.0f;
+    });
+
+    float* scalars = out + POLICY_CHANNEL_COUNT * plane;
+    scalars[0] = ship.halite * halite_scale;
+    scalars[1] = deposit_distance(game, ship) / POLICY_DISTANCE_SCALE;
+}
+
+int PolicyInputs::deposit_distance(const Game& game, const Ship& ship) {
+    GameMap* game_map = game.game_map.get();
+    int distance = game_map->calculate_distance(ship.position, game.me->shipyard->position);
+    for (const auto& dropoff_pair : game.me->dropoffs) {
+        distance = std::min(distance, game_map->calculate_distance(ship.position, dropoff_pair.second->position));
+    }
+    return distance;
+}
+
+bool MovePolicy::load(const string& path) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    vector<uint8_t> bytes;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), file)) > 0) bytes.insert(bytes.end(), chunk, chunk + n);
+    std::fclose(file);
+    if (!parse(bytes)) {
+        log::log("policy: " + path + " is not a valid weights file");
+        return false;
+    }
+    return true;
+}
+
+bool MovePolicy::parse(const vector<uint8_t>& bytes) {
+    hidden_ = 0;
+    PolicyFileHeader header;
+    if (bytes.size() < sizeof(header)) return false;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != POLICY_MAGIC || header.version != POLICY_VERSION) return false;
+    if (header.channels != POLICY_CHANNEL_COUNT || header.scalars != POLICY_SCALAR_COUNT) return false;
+    if (header.radius > POLICY_MAX_RADIUS || header.hidden == 0) return false;
+
+    int inputs = policy_input_count(header.radius);
+    int hidden = header.hidden;
+    size_t floats = static_cast<size_t>(inputs) * hidden + hidden + POLICY_MOVES * hidden + POLICY_MOVES;
+    if (bytes.size() != sizeof(header) + floats * sizeof(float)) return false;
+
+    const uint8_t* p = bytes.data() + sizeof(header);
+    auto read = [&p](vector<float>& out, size_t count) {
+        out.resize(count);
+        std::memcpy(out.data(), p, count * sizeof(float));
+        p += count * sizeof(float);
+    };
+    read(w1_, static_cast<size_t>(inputs) * hidden);
+    read(b1_, hidden);
+    read(w2_, static_cast<size_t>(POLICY_MOVES) * hidden);
+    read(b2_, POLICY_MOVES);
+
+    inputs_ = PolicyInputs(header.radius);
+    hidden_ = hidden;
+    hidden_values_.assign(hidden_, 0.0f);
+    return true;
+}
+
+void MovePolicy::reserve(size_t ships) {
+    batch_.resize(ships * inputs_.count());
+    scores_.resize(ships);
+    rows_.reserve(ships);
+}
+
+void MovePolicy::evaluate(const Game& game) {
+    Clock::time_point start = Clock::now();
+    const SimdKernels& kernels = simd_kernels();
+    int inputs = inputs_.count();
+
+    inputs_.prepare(game);
+    rows_.clear();
+    size_t ships = game.me->ships.size();
+    if (scores_.size() < ships) reserve(ships);
+
+    for (const auto& ship_pair : game.me->ships) {
+        int row = static_cast<int>(rows_.size());
+        rows_.emplace_back(ship_pair.first, row);
+        inputs_.features(game, *ship_pair.second, &batch_[static_cast<size_t>(row) * inputs]);
+    }
+
+    // Hidden layer as a sum of weight rows scaled by the inputs: the occupancy planes are mostly zero
+    float* h = hidden_values_.data();
+    for (size_t row = 0; row < ships; ++row) {
+        const float* x = &batch_[row * inputs];
+        std::copy(b1_.begin(), b1_.end(), h);
+        for (int i = 0; i < inputs; ++i) {
+            if (x[i] != 0.0f) kernels.axpy(h, &w1_[static_cast<size_t>(i) * hidden_], hidden_, x[i]);
+        }
+        array<float, POLICY_MOVES>& out = scores_[row];
+        for (int k = 0; k < POLICY_MOVES; ++k) {
+            const float* w = &w2_[k * hidden_];
+            float sum = b2_[k];
+            for (int j = 0; j < hidden_; ++j) sum += w[j] * std::max(h[j], 0.0f);
+            out[k] = sum;
+        }
+    }
+
+    std::sort(rows_.begin(), rows_.end());
+    last_us_ = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+const float* MovePolicy::scores(EntityId id) const {
+    auto it = std::lower_bound(rows_.begin(), rows_.end(), make_pair(id, 0));
+    if (it == rows_.end() || it->first != id) return nullptr;
+    return scores_[it->second].data();
+}
+
+Direction MovePolicy::choose(const Ship& ship, GameMap* game_map_ptr, const CellGrid<uint8_t>& next_turn_occupied) const {
+    const float* s = scores(ship.id);
+    if (!s) return Direction::STILL;
+
+    // Score k is the move to neighbour slot k
+    CellId here = game_map_ptr->cell_id(ship.position);
+    Direction best = Direction::STILL;
+    float best_score = s[NEIGHBOUR_STILL];
+    for (int k = 0; k < NEIGHBOUR_STILL; ++k) {
+        if (s[k] <= best_score) continue;
+        if (next_turn_occupied.at(game_map_ptr->topology->neighbour(here, k))) continue;
+        best = ALL_CARDINALS[k];
+        best_score = s[k];
+    }
+    return best;
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+#include "bot_simd.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Learned per-ship move policy: a one hidden layer perceptron scoring the 5
+// moves of a ship from the square window of radius R around it.
+//
+// Inputs, in order:
+//   POLICY_CHANNEL_COUNT planes of (2R+1)^2 cells, cell (dx, dy) at
+//   (dy + R) * (2R + 1) + (dx + R):
+//     halite / MAX_HALITE, 1 on our ships, 1 on enemy ships
+//   cargo / MAX_HALITE
+//   manhattan distance to our nearest deposit / POLICY_DISTANCE_SCALE
+// Outputs: one score per move, N, S, E, W then STILL (CellTopology order).
+//
+// Weights file (little endian): PolicyFileHeader, then float32
+//   w1[inputs][hidden]  (input major: a zero input skips its row)
+//   b1[hidden]
+//   w2[5][hidden]
+//   b2[5]
+static const uint32_t POLICY_MAGIC = 0x59434c50; // "PLCY"
+static const uint32_t POLICY_VERSION = 1;
+
+enum PolicyChannel {
+    POLICY_HALITE,
+    POLICY_ALLY,
+    POLICY_ENEMY,
+    POLICY_CHANNEL_COUNT
+};
+static const int POLICY_SCALAR_COUNT = 2;
+static const int POLICY_MOVES = 5;
+static const float POLICY_DISTANCE_SCALE = 32.0f;
+
+struct PolicyFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint16_t radius;
+    uint16_t channels;
+    uint16_t scalars;
+    uint16_t hidden;
+};
+
+static_assert(sizeof(PolicyFileHeader) == 16, "policy file layout");
+
+inline int policy_input_count(int radius) {
+    return POLICY_CHANNEL_COUNT * (2 * radius + 1) * (2 * radius + 1) + POLICY_SCALAR_COUNT;
+}
+
+// Builds the policy inputs of our ships, for the policy and for training data
+class PolicyInputs {
+public:
+    // What stands on a cell this turn
+    enum Occupant : uint8_t {
+        EMPTY,
+        ALLY,
+        ENEMY
+    };
+
+    explicit PolicyInputs(int radius = 0) : radius_(radius) {}
+
+    int radius() const { return radius_; }
+    int count() const { return policy_input_count(radius_); }
+
+    // Index the ships of the turn by cell; call once per turn before features() or crop()
+    void prepare(const Game& game);
+
+    // Inputs of one of our ships (out holds count() floats)
+    void features(const Game& game, const Ship& ship, float* out) const;
+
+    // visit(i, cell, occupant) on every cell of the window around the ship, i in input plane order
+    template <typename Visit>
+    void crop(const Game& game, const Ship& ship, Visit&& visit) const {
+        const GameMap& game_map = *game.game_map;
+        int width = game_map.width;
+        int height = game_map.height;
+        int i = 0;
+        for (int dy = -radius_; dy <= radius_; ++dy) {
+            int y = ((ship.position.y + dy) % height + height) % height;
+            auto row = game_map.cells[y];
+            const uint8_t* occupants = &occupant_[y * width_];
+            for (int dx = -radius_; dx <= radius_; ++dx, ++i) {
+                int x = ((ship.position.x + dx) % width + width) % width;
+                visit(i, row[x], static_cast<Occupant>(occupants[x]));
+            }
+        }
+    }
+
+    // Manhattan distance from the ship to our nearest shipyard or dropoff
+    static int deposit_distance(const Game& game, const Ship& ship);
+
+private:
+    int radius_;
+    int width_ = 0;
+    vector<uint8_t> occupant_;  // Occupant per cell
+};
+
+class MovePolicy {
+public:
+    // Read a weights file; false (and the policy stays unloaded) if it is missing or malformed
+    bool load(const string& path);
+    // Same from the file's bytes
+    bool parse(const vector<uint8_t>& bytes);
+
+    bool loaded() const { return hidden_ > 0; }
+    int radius() const { return inputs_.radius(); }
+    int hidden() const { return hidden_; }
+
+    // Size the per-turn buffers for this many ships
+    void reserve(size_t ships);
+
+    // Score the moves of all our ships in one batch
+    void evaluate(const Game& game);
+
+    // Best scoring move of a ship whose destination is free (STILL when none is); the ship must have been evaluated
+    Direction choose(const Ship& ship, GameMap* game_map_ptr, const CellGrid<uint8_t>& next_turn_occupied) const;
+
+    // Scores of a ship's moves from the last evaluate(), nullptr if it wasn't evaluated
+    const float* scores(EntityId id) const;
+
+    // Wall time of the last evaluate()
+    double last_us() const { return last_us_; }
+
+private:
+    PolicyInputs inputs_;
+    int hidden_ = 0;
+    vector<float> w1_;
+    vector<float> b1_;
+    vector<float> w2_;
+    vector<float> b2_;
+
+    vector<float> batch_;                    // ships x inputs
+    vector<float> hidden_values_;
+    vector<array<float, POLICY_MOVES>> scores_;
+    vector<pair<EntityId, int>> rows_;       // ship id -> row of batch_ / scores_, sorted by id
+    double last_us_ = 0.0;
+};
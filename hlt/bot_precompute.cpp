@@ -0,0 +1,93 @@
+#include "bot_precompute.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+
+using Clock = std::chrono::steady_clock;
+
+static double elapsed_ms(Clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+static shared_ptr<const ExtractionTables> build_extraction_tables() {
+    shared_ptr<ExtractionTables> tables = make_shared<ExtractionTables>();
+    tables->extract_ratio = constants::EXTRACT_RATIO;
+    tables->move_cost_ratio = constants::MOVE_COST_RATIO;
+
+    // Cells can hold more than MAX_HALITE after collisions, cover twice that
+    size_t size = static_cast<size_t>(constants::MAX_HALITE) * 2 + 1;
+    tables->extract_amount.resize(size);
+    tables->move_cost.resize(size);
+    for (size_t h = 0; h < size; ++h) {
+        int halite = static_cast<int>(h);
+        tables->extract_amount[h] = (halite + constants::EXTRACT_RATIO - 1) / constants::EXTRACT_RATIO;
+        tables->move_cost[h] = (halite + constants::MOVE_COST_RATIO - 1) / constants::MOVE_COST_RATIO;
+    }
+    return tables;
+}
+
+static std::mutex shared_tables_mutex;
+
+shared_ptr<const ExtractionTables> shared_extraction_tables() {
+    static vector<shared_ptr<const ExtractionTables>> cache;
+
+    lock_guard<std::mutex> lock(shared_tables_mutex);
+    size_t size = static_cast<size_t>(constants::MAX_HALITE) * 2 + 1;
+    for (const auto& tables : cache) {
+        if (tables->extract_ratio == constants::EXTRACT_RATIO &&
+            tables->move_cost_ratio == constants::MOVE_COST_RATIO &&
+            tables->extract_amount.size() == size) {
+            return tables;
+        }
+    }
+    cache.push_back(build_extraction_tables());
+    return cache.back();
+}
+
+static void analyse_symmetry(StartupTables& tables, GameMap* game_map_ptr) {
+    int w = tables.width;
+    int h = tables.height;
+
+    tables.mirror_x = true;
+    tables.mirror_y = true;
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            int halite = game_map_ptr->cells[y][x].halite;
+            if (halite != game_map_ptr->cells[y][w - 1 - x].halite) tables.mirror_x = false;
+            if (halite != game_map_ptr->cells[h - 1 - y][x].halite) tables.mirror_y = false;
+        }
+    }
+}
+
+vector<StartupStepTiming> build_startup_tables(StartupTables& tables, Game& game, double budget_ms) {
+    GameMap* game_map_ptr = game.game_map.get();
+    tables.width = game_map_ptr->width;
+    tables.height = game_map_ptr->height;
+
+    vector<StartupStepTiming> report;
+    Clock::time_point start = Clock::now();
+
+    // Required steps run regardless of the budget, optional ones are skipped once it is spent
+    auto run_step = [&](const string& name, bool required, const std::function<void()>& step) {
+        StartupStepTiming timing;
+        timing.name = name;
+        if (!required && elapsed_ms(start) >= budget_ms) {
+            timing.skipped = true;
+        }
+        else {
+            Clock::time_point step_start = Clock::now();
+            step();
+            timing.ms = elapsed_ms(step_start);
+        }
+        report.push_back(timing);
+    };
+
+    run_step("neighbours+distance", true, [&]() { tables.geometry = shared_cell_topology(tables.width, tables.height); });
+    run_step("extraction", true, [&]() { tables.extraction = shared_extraction_tables(); });
+    run_step("symmetry", false, [&]() { analyse_symmetry(tables, game_map_ptr); });
+
+    return report;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "cell_id.hpp"
+
+#include "bot_config.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Per-halite lookup tables, which only depend on the game constants
+struct ExtractionTables {
+    int extract_ratio = 0;
+    int move_cost_ratio = 0;
+
+    // Halite mined in one turn / move cost for a cell holding h (h < extract_amount.size())
+    vector<int> extract_amount;
+    vector<int> move_cost;
+};
+
+// Read-only tables are shared by every game hosted in the process (see bot_server),
+// like the CellTopology of each map size (see cell_id.hpp)
+shared_ptr<const ExtractionTables> shared_extraction_tables();
+
+// Tables built once, after the map is parsed and before ready()
+struct StartupTables {
+    int width = 0;
+    int height = 0;
+
+    shared_ptr<const CellTopology> geometry;
+    shared_ptr<const ExtractionTables> extraction;
+
+    // Mirror symmetry of the initial map
+    bool mirror_x = false; // halite[y][x] == halite[y][width - 1 - x]
+    bool mirror_y = false; // halite[y][x] == halite[height - 1 - y][x]
+
+    int distance(const Position& a, const Position& b) const {
+        return geometry->distance(a, b);
+    }
+
+    int extract(int halite) const {
+        if (halite < static_cast<int>(extraction->extract_amount.size())) return extraction->extract_amount[halite];
+        return (halite + constants::EXTRACT_RATIO - 1) / constants::EXTRACT_RATIO;
+    }
+
+    int cost_to_move(int halite) const {
+        if (halite < static_cast<int>(extraction->move_cost.size())) return extraction->move_cost[halite];
+        return (halite + constants::MOVE_COST_RATIO - 1) / constants::MOVE_COST_RATIO;
+    }
+};
+
+struct StartupStepTiming {
+    string name;
+    double ms = 0.0;
+    bool skipped = false;
+};
+
+// Build every table, skipping optional steps once budget_ms is spent
+vector<StartupStepTiming> build_startup_tables(StartupTables& tables, Game& game, double budget_ms);
@@ -0,0 +1,55 @@
+#include "bot_record_file.hpp"
+
+RecordFileWriter::~RecordFileWriter() {
+    if (!file_) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+    std::fclose(file_);
+}
+
+bool RecordFileWriter::open(const string& path) {
+    file_ = std::fopen(path.c_str(), "ab");
+    if (!file_) return false;
+    // Unbuffered: every record is one append, so games sharing a file don't interleave
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+    thread_ = std::thread(&RecordFileWriter::writer_loop, this);
+    return true;
+}
+
+vector<uint8_t> RecordFileWriter::take_buffer() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (spare_.empty()) return vector<uint8_t>();
+    vector<uint8_t> buffer = std::move(spare_.back());
+    spare_.pop_back();
+    buffer.clear();
+    return buffer;
+}
+
+void RecordFileWriter::submit(vector<uint8_t>&& record) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.push_back(std::move(record));
+    }
+    wake_.notify_one();
+}
+
+void RecordFileWriter::writer_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [&]() { return stopping_ || !pending_.empty(); });
+        if (pending_.empty()) break;
+
+        vector<uint8_t> record = std::move(pending_.front());
+        pending_.pop_front();
+
+        lock.unlock();
+        std::fwrite(record.data(), 1, record.size(), file_);
+        lock.lock();
+
+        spare_.push_back(std::move(record));
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Append-only record files (snapshot archives, training datasets): every record
+// starts with a RecordHeader giving its type and its size, header included, so
+// readers can skip records without parsing them. Fields are little endian.
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t size;
+};
+
+static_assert(sizeof(RecordHeader) == 8, "record layout");
+
+template <typename T>
+inline void record_append(vector<uint8_t>& out, const T& value) {
+    size_t offset = out.size();
+    out.resize(offset + sizeof(T));
+    std::memcpy(&out[offset], &value, sizeof(T));
+}
+
+// Start a record at the beginning of out (its size is patched by record_close)
+inline void record_begin(vector<uint8_t>& out, uint32_t magic) {
+    RecordHeader header = { magic, 0 };
+    record_append(out, header);
+}
+
+inline void record_close(vector<uint8_t>& out) {
+    uint32_t size = static_cast<uint32_t>(out.size());
+    std::memcpy(&out[offsetof(RecordHeader, size)], &size, sizeof(size));
+}
+
+// Appends records to a file from a background thread, so the game thread only
+// pays for encoding them. Record buffers are recycled: take_buffer() hands back
+// one that was already written, so steady-state turns don't allocate.
+class RecordFileWriter {
+public:
+    RecordFileWriter() = default;
+    RecordFileWriter(const RecordFileWriter&) = delete;
+    RecordFileWriter& operator=(const RecordFileWriter&) = delete;
+
+    // Flushes every pending record
+    ~RecordFileWriter();
+
+    // Open path for appending. Returns false if the file can't be opened.
+    bool open(const string& path);
+    bool is_open() const { return file_ != nullptr; }
+
+    // An empty buffer to encode the next record into
+    vector<uint8_t> take_buffer();
+    // Queue a whole record for writing
+    void submit(vector<uint8_t>&& record);
+
+private:
+    void writer_loop();
+
+    FILE* file_ = nullptr;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    deque<vector<uint8_t>> pending_;
+    vector<vector<uint8_t>> spare_;
+    bool stopping_ = false;
+};
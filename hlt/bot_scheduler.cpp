@@ -0,0 +1,159 @@
+#include "bot_scheduler.hpp"
+
+#include <chrono>
+
+using Clock = std::chrono::steady_clock;
+
+void TaskScheduler::TaskQueue::push_back(int task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    items[(head + count) % items.size()] = task;
+    ++count;
+}
+
+bool TaskScheduler::TaskQueue::pop_back(int& task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0) return false;
+    --count;
+    task = items[(head + count) % items.size()];
+    return true;
+}
+
+bool TaskScheduler::TaskQueue::pop_front(int& task) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (count == 0) return false;
+    task = items[head];
+    head = (head + 1) % static_cast<int>(items.size());
+    --count;
+    return true;
+}
+
+TaskScheduler::TaskScheduler(int threads)
+    : remaining_(0), constants_(constants::save()) {
+    if (threads <= 0) threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads <= 0) threads = 1;
+    for (int t = 0; t < threads; ++t) queues_.emplace_back(new TaskQueue());
+    for (int t = 1; t < threads; ++t) workers_.emplace_back(&TaskScheduler::worker, this, t);
+}
+
+TaskScheduler::~TaskScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : workers_) t.join();
+}
+
+int TaskScheduler::add(const string& name, uint64_t reads, uint64_t writes, function<void()> work) {
+    Task task;
+    task.name = name;
+    task.reads = reads;
+    task.writes = writes;
+    task.work = std::move(work);
+    tasks_.push_back(std::move(task));
+    linked_ = false;
+    return static_cast<int>(tasks_.size()) - 1;
+}
+
+void TaskScheduler::link() {
+    int count = task_count();
+    for (Task& task : tasks_) {
+        task.successors.clear();
+        task.predecessors = 0;
+    }
+    // Read after write, write after read and write after write, against every earlier task
+    for (int j = 0; j < count; ++j) {
+        for (int i = 0; i < j; ++i) {
+            const Task& a = tasks_[i];
+            const Task& b = tasks_[j];
+            if ((a.writes & (b.reads | b.writes)) || (a.reads & b.writes)) {
+                tasks_[i].successors.push_back(j);
+                ++tasks_[j].predecessors;
+            }
+        }
+    }
+    pending_.reset(new std::atomic<int>[count]);
+    for (auto& queue : queues_) queue->items.assign(count > 0 ? count : 1, 0);
+    linked_ = true;
+}
+
+void TaskScheduler::time(Task& t) {
+    Clock::time_point start = Clock::now();
+    t.work();
+    t.last_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    t.total_us += t.last_us;
+}
+
+void TaskScheduler::execute(int task, int thread) {
+    Task& t = tasks_[task];
+    time(t);
+
+    for (int s : t.successors) {
+        if (pending_[s].fetch_sub(1, std::memory_order_acq_rel) == 1) queues_[thread]->push_back(s);
+    }
+    remaining_.fetch_sub(1, std::memory_order_release);
+}
+
+bool TaskScheduler::next_task(int thread, int& task) {
+    if (queues_[thread]->pop_back(task)) return true;
+    int threads = this->threads();
+    for (int k = 1; k < threads; ++k) {
+        if (queues_[(thread + k) % threads]->pop_front(task)) return true;
+    }
+    return false;
+}
+
+void TaskScheduler::work_until_done(int thread) {
+    int task;
+    while (remaining_.load(std::memory_order_acquire) > 0) {
+        if (next_task(thread, task)) execute(task, thread);
+        else std::this_thread::yield();
+    }
+}
+
+void TaskScheduler::worker(int thread) {
+    constants::restore(constants_);
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&]() { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+        }
+        work_until_done(thread);
+    }
+}
+
+void TaskScheduler::run() {
+    if (!linked_) link();
+    ++runs_;
+
+    if (workers_.empty()) {
+        // Inline: add() order already respects every dependency
+        for (Task& task : tasks_) time(task);
+        return;
+    }
+
+    int count = task_count();
+    for (int i = 0; i < count; ++i) pending_[i].store(tasks_[i].predecessors, std::memory_order_relaxed);
+    remaining_.store(count, std::memory_order_release);
+    for (int i = 0; i < count; ++i) {
+        if (tasks_[i].predecessors == 0) queues_[0]->push_back(i);
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++generation_;
+    }
+    wake_.notify_all();
+    work_until_done(0);
+}
+
+string TaskScheduler::timings() const {
+    string text;
+    for (const Task& task : tasks_) {
+        if (!text.empty()) text += ", ";
+        text += task.name + " " + to_string(static_cast<int>(task.last_us)) + "us";
+    }
+    return text;
+}
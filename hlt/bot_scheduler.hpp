@@ -0,0 +1,102 @@
+#pragma once
+
+#include "constants.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Runs a fixed graph of per-turn analyses across a persistent thread pool.
+//
+// Each task declares the data it reads and writes as bit masks; a task runs
+// after every earlier task (in add() order) that writes what it reads, or
+// reads or writes what it writes. run() executes the whole graph once and
+// returns when it is done, the calling thread working alongside the pool.
+// Every thread has its own task deque: it pushes the tasks it makes ready and
+// pops them from the back, and steals from the front of the others' when it
+// runs out. With one thread the tasks simply run inline in add() order.
+//
+// Workers start with the constants of the thread that built the scheduler.
+// Tasks must not log (the log sink is per thread) nor throw.
+class TaskScheduler {
+public:
+    // threads: total threads including the caller's (0: one per core)
+    explicit TaskScheduler(int threads);
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    // Declare a task (before the first run)
+    int add(const string& name, uint64_t reads, uint64_t writes, function<void()> work);
+
+    void run();
+
+    int threads() const { return static_cast<int>(queues_.size()); }
+    int task_count() const { return static_cast<int>(tasks_.size()); }
+    const string& name(int task) const { return tasks_[task].name; }
+    // Wall time of the task on its last run, and summed over all runs
+    double last_us(int task) const { return tasks_[task].last_us; }
+    double total_us(int task) const { return tasks_[task].total_us; }
+    int runs() const { return runs_; }
+
+    // "<name> <last us>, ..." for the last run
+    string timings() const;
+
+private:
+    struct Task {
+        string name;
+        uint64_t reads;
+        uint64_t writes;
+        function<void()> work;
+        vector<int> successors;
+        int predecessors = 0;
+        double last_us = 0.0;
+        double total_us = 0.0;
+    };
+
+    // Ring buffer deque sized for every task, so pushes never allocate
+    struct TaskQueue {
+        std::mutex mutex;
+        vector<int> items;
+        int head = 0;
+        int count = 0;
+
+        void push_back(int task);
+        bool pop_back(int& task);
+        bool pop_front(int& task);
+    };
+
+    void link();
+    void time(Task& task);
+    void execute(int task, int thread);
+    bool next_task(int thread, int& task);
+    void work_until_done(int thread);
+    void worker(int thread);
+
+    vector<Task> tasks_;
+    unique_ptr<std::atomic<int>[]> pending_;
+    bool linked_ = false;
+    int runs_ = 0;
+
+    vector<unique_ptr<TaskQueue>> queues_;
+    std::atomic<int> remaining_;
+    constants::Snapshot constants_;
+
+    // Workers sleep between runs, woken by a new generation
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+
+    vector<std::thread> workers_;
+};
@@ -0,0 +1,419 @@
+#include "bot_server.hpp"
+
+#include "input.hpp"
+
+#include "bot_controller.hpp"
+
+#ifndef _WIN32
+
+#include <condition_variable>
+#include <deque>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cerrno>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#ifndef MSG_NOSIGNAL
+# define MSG_NOSIGNAL 0
+#endif
+
+// Input side: one complete frame, already read from the socket by the poll thread
+class FrameBuf : public std::streambuf {
+public:
+    void load(const string& frame) {
+        char* begin = const_cast<char*>(frame.data());
+        setg(begin, begin, begin + frame.size());
+    }
+};
+
+// Output side: writes to the (non-blocking) socket, waiting for room when it is full
+class FdStreamBuf : public std::streambuf {
+public:
+    explicit FdStreamBuf(int fd) : fd_(fd) {
+        setp(out_, out_ + sizeof(out_));
+    }
+
+protected:
+    int_type overflow(int_type c) override {
+        if (flush_output() < 0) return traits_type::eof();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int sync() override {
+        return flush_output();
+    }
+
+private:
+    int flush_output() {
+        const char* p = pbase();
+        while (p < pptr()) {
+            ssize_t n = ::send(fd_, p, pptr() - p, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                pollfd writable = { fd_, POLLOUT, 0 };
+                ::poll(&writable, 1, -1);
+                continue;
+            }
+            if (n <= 0) return -1;
+            p += n;
+        }
+        setp(out_, out_ + sizeof(out_));
+        return 0;
+    }
+
+    int fd_;
+    char out_[1 << 12];
+};
+
+// Finds where a frame of the engine protocol ends by counting its lines. The
+// startup frame gives the player count the turn frames are sized by.
+class FrameScanner {
+public:
+    // Length of the complete frame at the start of data, 0 while it is still arriving
+    size_t complete_frame(const string& data) {
+        size_t pos = 0;
+        const char* line;
+        if (players_ == 0) {
+            // Constants, "players my_id", one shipyard per player, "width height", one line per row
+            int players = 0;
+            int width = 0;
+            int height = 0;
+            if (!next_line(data, pos, line) || !next_line(data, pos, line)) return 0;
+            parse(line, { &players });
+            if (!skip_lines(data, pos, players) || !next_line(data, pos, line)) return 0;
+            parse(line, { &width, &height });
+            if (!skip_lines(data, pos, height)) return 0;
+            players_ = players;
+            return pos;
+        }
+
+        // Turn number, per player "id ships dropoffs halite" and its entities, then the cell updates
+        if (!next_line(data, pos, line)) return 0;
+        for (int p = 0; p < players_; ++p) {
+            int id = 0;
+            int ships = 0;
+            int dropoffs = 0;
+            if (!next_line(data, pos, line)) return 0;
+            parse(line, { &id, &ships, &dropoffs });
+            if (!skip_lines(data, pos, ships + dropoffs)) return 0;
+        }
+        int updates = 0;
+        if (!next_line(data, pos, line)) return 0;
+        parse(line, { &updates });
+        return skip_lines(data, pos, updates) ? pos : 0;
+    }
+
+private:
+    static bool next_line(const string& data, size_t& pos, const char*& line) {
+        const void* end = pos < data.size() ? std::memchr(data.data() + pos, '\n', data.size() - pos) : nullptr;
+        if (!end) return false;
+        line = data.data() + pos;
+        pos = static_cast<const char*>(end) - data.data() + 1;
+        return true;
+    }
+
+    static bool skip_lines(const string& data, size_t& pos, int count) {
+        const char* line;
+        for (int i = 0; i < count; ++i) {
+            if (!next_line(data, pos, line)) return false;
+        }
+        return true;
+    }
+
+    // Leading integers of a line (it ends with '\n', which stops strtol)
+    static void parse(const char* line, std::initializer_list<int*> values) {
+        for (int* value : values) {
+            char* end;
+            *value = static_cast<int>(std::strtol(line, &end, 10));
+            line = end;
+        }
+    }
+
+    int players_ = 0;
+};
+
+// One hosted game
+struct Session {
+    Session(int fd, int id, unsigned int seed)
+        : fd(fd), id(id), out_buffer(fd), in(&frame_buffer), out(&out_buffer), rng(seed) {
+        log_sink.prefix = "session-" + to_string(id) + "-";
+        inbox.reserve(1 << 16);
+        frame.reserve(1 << 16);
+    }
+
+    // Move the next complete frame from the inbox to the worker's input. Returns false while it is still arriving.
+    bool take_frame() {
+        size_t length = scanner.complete_frame(inbox);
+        if (length == 0) return false;
+        frame.assign(inbox, 0, length);
+        inbox.erase(0, length);
+        frame_buffer.load(frame);
+        in.clear();
+        return true;
+    }
+
+    // Play the next step (startup or one turn). Returns false once the game is over.
+    bool step(const string& bot_name) {
+        GameStreams& streams = game_streams();
+        streams.in = &in;
+        streams.out = &out;
+        streams.exit_on_close = false;
+        log::use_sink(&log_sink);
+        if (game) constants::restore(constants);
+
+        bool running = true;
+        try {
+            if (!game) {
+                game.reset(new Game());
+                constants = constants::save();
+                // The server's worker pool already uses every core: turn tasks run inline
+                bot.reset(new BotController(rng, 1));
+                bot->init(*game, STARTUP_BUDGET_MS);
+                game->ready(bot_name);
+            }
+            else {
+                game->update_frame();
+                const vector<Command>& command_queue = bot->play_turn(*game);
+                running = game->end_turn(command_queue);
+            }
+        }
+        catch (const InputClosed&) {
+            running = false;
+        }
+
+        streams = GameStreams();
+        log::use_sink(nullptr);
+        return running;
+    }
+
+    int fd;
+    int id;
+    bool busy = false;
+    bool closed = false;     // The engine closed its end: no frame will follow what is in the inbox
+
+    // Poll thread only: bytes read from the socket, the next frame(s) in the making
+    string inbox;
+    FrameScanner scanner;
+    // The frame handed to the worker
+    string frame;
+    FrameBuf frame_buffer;
+    FdStreamBuf out_buffer;
+    std::istream in;
+    std::ostream out;
+    log::Sink log_sink;
+
+    constants::Snapshot constants;
+    mt19937 rng;
+    unique_ptr<Game> game;
+    unique_ptr<BotController> bot;
+};
+
+// Sessions waiting for a worker, and sessions a worker is done with
+struct ServerQueues {
+    std::mutex mutex;
+    std::condition_variable ready;
+    deque<Session*> pending;
+    vector<pair<Session*, bool>> done; // (session, still running)
+    bool stop = false;                 // Workers return instead of taking more sessions
+    int wake_fd = -1;
+};
+
+static void worker_loop(ServerQueues& queues, const string& bot_name) {
+    for (;;) {
+        Session* session;
+        {
+            std::unique_lock<std::mutex> lock(queues.mutex);
+            queues.ready.wait(lock, [&]() { return queues.stop || !queues.pending.empty(); });
+            if (queues.stop) return;
+            session = queues.pending.front();
+            queues.pending.pop_front();
+        }
+
+        bool running = session->step(bot_name);
+
+        {
+            std::lock_guard<std::mutex> lock(queues.mutex);
+            queues.done.emplace_back(session, running);
+        }
+        char byte = 0;
+        ssize_t ignored = ::write(queues.wake_fd, &byte, 1);
+        (void)ignored;
+    }
+}
+
+static int open_listen_socket(const string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        log::log("server: socket path too long: " + path);
+        return -1;
+    }
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    ::unlink(path.c_str());
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || ::listen(fd, 64) < 0) {
+        log::log("server: cannot listen on " + path + ": " + std::strerror(errno));
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+int run_bot_server(const ServerOptions& options) {
+    int listen_fd = open_listen_socket(options.socket_path);
+    if (listen_fd < 0) return 1;
+
+    // A game dropped by the engine must not kill the others
+    std::signal(SIGPIPE, SIG_IGN);
+
+    int wake_pipe[2];
+    if (::pipe(wake_pipe) < 0) return 1;
+    ::fcntl(wake_pipe[0], F_SETFL, O_NONBLOCK);
+
+    ServerQueues queues;
+    queues.wake_fd = wake_pipe[1];
+
+    int workers = options.workers > 0 ? options.workers : static_cast<int>(std::thread::hardware_concurrency());
+    if (workers <= 0) workers = 1;
+    vector<std::thread> pool;
+    for (int i = 0; i < workers; ++i) {
+        pool.emplace_back(worker_loop, std::ref(queues), std::cref(options.bot_name));
+    }
+    log::log("server: listening on " + options.socket_path + " with " + to_string(workers) + " workers");
+
+    // Owned by this thread; workers only see the sessions handed to them
+    map<int, unique_ptr<Session>> sessions;
+    int next_id = 0;
+
+    auto dispatch = [&](Session* session) {
+        session->busy = true;
+        {
+            std::lock_guard<std::mutex> lock(queues.mutex);
+            queues.pending.push_back(session);
+        }
+        queues.ready.notify_one();
+    };
+
+    auto finish = [&](Session* session) {
+        log::log("server: game " + to_string(session->id) + " finished");
+        int fd = session->fd;
+        sessions.erase(fd);
+        ::close(fd);
+    };
+
+    // Hand an idle session its next frame; once the engine is gone, there is none
+    auto advance = [&](Session* session) {
+        if (session->take_frame()) dispatch(session);
+        else if (session->closed) finish(session);
+        else session->busy = false;
+    };
+
+    // Drain the socket of an idle session into its inbox (the fd is non-blocking)
+    vector<char> chunk(1 << 16);
+    auto receive = [&](Session* session) {
+        for (;;) {
+            ssize_t n = ::read(session->fd, chunk.data(), chunk.size());
+            if (n > 0) {
+                session->inbox.append(chunk.data(), n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR) continue;
+            if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) session->closed = true;
+            return;
+        }
+    };
+
+    vector<pollfd> fds;
+    for (;;) {
+        fds.clear();
+        fds.push_back({ listen_fd, POLLIN, 0 });
+        fds.push_back({ wake_pipe[0], POLLIN, 0 });
+        for (const auto& entry : sessions) {
+            if (!entry.second->busy) fds.push_back({ entry.first, POLLIN, 0 });
+        }
+
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            log::log(string("server: poll failed: ") + std::strerror(errno));
+            break;
+        }
+
+        if (fds[0].revents & POLLIN) {
+            int fd = ::accept(listen_fd, nullptr, nullptr);
+            if (fd >= 0) {
+                ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+                int id = next_id++;
+                sessions[fd].reset(new Session(fd, id, options.rng_seed + static_cast<unsigned int>(id)));
+                log::log("server: game " + to_string(id) + " connected");
+            }
+        }
+
+        if (fds[1].revents & POLLIN) {
+            char drain[256];
+            while (::read(wake_pipe[0], drain, sizeof(drain)) > 0) {}
+
+            vector<pair<Session*, bool>> done;
+            {
+                std::lock_guard<std::mutex> lock(queues.mutex);
+                done.swap(queues.done);
+            }
+            for (const auto& entry : done) {
+                if (entry.second) advance(entry.first);
+                else finish(entry.first);
+            }
+        }
+
+        for (size_t i = 2; i < fds.size(); ++i) {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            Session* session = sessions[fds[i].fd].get();
+            receive(session);
+            advance(session);
+        }
+    }
+
+    // Workers finish the step they are on, then the games still open are dropped
+    {
+        std::lock_guard<std::mutex> lock(queues.mutex);
+        queues.stop = true;
+    }
+    queues.ready.notify_all();
+    for (auto& thread : pool) thread.join();
+    for (const auto& entry : sessions) ::close(entry.first);
+    sessions.clear();
+    ::close(wake_pipe[0]);
+    ::close(wake_pipe[1]);
+    ::close(listen_fd);
+    return 1;
+}
+
+#else
+
+int run_bot_server(const ServerOptions& options) {
+    log::log("server: not supported on this platform (" + options.socket_path + ")");
+    return 1;
+}
+
+#endif
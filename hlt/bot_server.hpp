@@ -0,0 +1,26 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+
+#include <string>
+
+using namespace std;
+using namespace hlt;
+
+// Server mode: one process plays many games at once. Every connection to the
+// Unix socket is one game speaking the usual engine protocol (the engine runs
+// e.g. `socat - UNIX-CONNECT:<socket_path>` as the bot command). Games share the
+// read-only startup tables and are stepped on a pool of worker threads.
+struct ServerOptions {
+    string socket_path;
+    int workers = 0;          // 0: one per hardware thread
+    string bot_name;
+    unsigned int rng_seed = 0; // game n uses rng_seed + n
+};
+
+// Serve games until the process is killed. Returns non-zero if the socket can't be opened.
+int run_bot_server(const ServerOptions& options);
@@ -0,0 +1,193 @@
+#include "bot_shadow.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+using Clock = std::chrono::steady_clock;
+
+// Index of a move in N, S, E, W, STILL order
+static int move_index(char direction) {
+    for (int k = 0; k < 4; ++k) {
+        if (static_cast<char>(ALL_CARDINALS[k]) == direction) return k;
+    }
+    return 4;
+}
+
+bool ShadowTurn::is_decided(EntityId id) const {
+    return std::binary_search(decided.begin(), decided.end(), id);
+}
+
+ShipState ShadowTurn::status_of(EntityId id) const {
+    auto it = std::lower_bound(status.begin(), status.end(), make_pair(id, ShipState::MINING));
+    return it != status.end() && it->first == id ? it->second : ShipState::MINING;
+}
+
+void LearnedShadowPolicy::play(ShadowTurn& turn, vector<pair<EntityId, Direction>>& moves) {
+    const Game& game = *turn.game;
+    GameMap* game_map = game.game_map.get();
+    CellGrid<uint8_t>& occupied = turn.next_turn_occupied;
+
+    policy_.evaluate(game);
+    for (const auto& ship_pair : game.me->ships) {
+        if (turn.cancelled()) return;
+        const Ship& ship = *ship_pair.second;
+        if (turn.is_decided(ship.id) || turn.status_of(ship.id) == ShipState::RETURNING) continue;
+
+        // Same rules as the live loop: STILL when the move can't be paid, a taken cell cancels the move
+        CellId here = game_map->cell_id(ship.position);
+        occupied.at(here) = false;
+        Direction direction = Direction::STILL;
+        if (ship.halite >= turn.tables->cost_to_move(game_map->at(here)->halite)) {
+            direction = policy_.choose(ship, game_map, occupied);
+        }
+        CellId target = game_map->neighbour(here, direction);
+        if (occupied.at(target)) {
+            direction = Direction::STILL;
+            target = here;
+        }
+        occupied.at(target) = true;
+        moves.emplace_back(ship.id, direction);
+    }
+}
+
+ShadowRunner::ShadowRunner(unique_ptr<ShadowPolicy> policy)
+    : policy_(std::move(policy)), cancel_(false), constants_(constants::save()) {
+    for (auto& row : confusion_) row.fill(0);
+    worker_ = std::thread(&ShadowRunner::run, this);
+}
+
+ShadowRunner::~ShadowRunner() {
+    cancel_ = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    worker_.join();
+}
+
+void ShadowRunner::reserve(size_t ships) {
+    policy_->reserve(ships);
+    moves_.reserve(ships);
+    live_.reserve(ships);
+    turn_.status.reserve(ships);
+    turn_.decided.reserve(ships);
+    last_disagreements_.reserve(ships * 12);
+}
+
+void ShadowRunner::run() {
+    constants::restore(constants_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this]() { return pending_ || stop_; });
+        if (stop_) return;
+        pending_ = false;
+        busy_ = true;
+        lock.unlock();
+
+        // turn_ and moves_ belong to this thread until busy_ is cleared
+        moves_.clear();
+        policy_->play(turn_, moves_);
+
+        lock.lock();
+        busy_ = false;
+        done_.notify_all();
+    }
+}
+
+void ShadowRunner::start(
+    const Game& game,
+    const StartupTables& tables,
+    const vector<vector<bool>>& inspired,
+    const CellGrid<float>& risk_map,
+    const TerritoryField* territory,
+    const CellGrid<uint8_t>& next_turn_occupied,
+    const ShipMemory& mem,
+    const vector<pair<EntityId, Direction>>& decided,
+    Clock::time_point deadline
+) {
+    turn_.game = &game;
+    turn_.tables = &tables;
+    turn_.inspired = &inspired;
+    turn_.risk_map = &risk_map;
+    turn_.territory = territory;
+    turn_.next_turn_occupied = next_turn_occupied;
+    turn_.status.clear();
+    for (const auto& status : mem.ship_status) turn_.status.push_back(status);
+    std::sort(turn_.status.begin(), turn_.status.end());
+    turn_.decided.clear();
+    for (const auto& move : decided) turn_.decided.push_back(move.first);
+    turn_.deadline = deadline;
+    turn_.cancel = &cancel_;
+    cancel_ = false;
+    started_ = Clock::now();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = true;
+    }
+    wake_.notify_one();
+}
+
+void ShadowRunner::finish(const vector<Command>& live_commands, const ShipMemory& mem) {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        bool done = done_.wait_until(lock, turn_.deadline, [this]() { return !pending_ && !busy_; });
+        last_cancelled_ = !done;
+        if (!done) {
+            cancel_ = true;
+            done_.wait(lock, [this]() { return !pending_ && !busy_; });
+        }
+    }
+    ++turns_;
+    total_us_ += std::chrono::duration<double, std::micro>(Clock::now() - started_).count();
+    if (last_cancelled_) ++cancelled_turns_;
+
+    // Live moves ("m <id> <dir>"), by ship
+    live_.clear();
+    for (const Command& command : live_commands) {
+        if (command.size() < 5 || command[0] != 'm') continue;
+        char* end = nullptr;
+        EntityId id = static_cast<EntityId>(std::strtol(command.c_str() + 2, &end, 10));
+        live_.emplace_back(id, *end ? end[1] : static_cast<char>(Direction::STILL));
+    }
+    std::sort(live_.begin(), live_.end());
+
+    // Only ships the live loop also treated as exploring: the shadow sees last turn's states
+    last_compared_ = 0;
+    last_agreed_ = 0;
+    last_disagreements_.clear();
+    for (const auto& move : moves_) {
+        auto live = std::lower_bound(live_.begin(), live_.end(), make_pair(move.first, '\0'));
+        if (live == live_.end() || live->first != move.first) continue;
+        auto status = mem.ship_status.find(move.first);
+        if (status == mem.ship_status.end() || status->second != ShipState::MINING) continue;
+
+        char shadow = static_cast<char>(move.second);
+        ++last_compared_;
+        ++confusion_[move_index(live->second)][move_index(shadow)];
+        if (live->second == shadow) {
+            ++last_agreed_;
+        }
+        else {
+            last_disagreements_ += to_string(move.first) + ":" + live->second + shadow + " ";
+        }
+    }
+    compared_ += last_compared_;
+    agreed_ += last_agreed_;
+}
+
+string ShadowRunner::summary() const {
+    char rate[32];
+    std::snprintf(rate, sizeof(rate), "%.3f", compared_ > 0 ? static_cast<double>(agreed_) / compared_ : 0.0);
+    string text = string("shadow ") + policy_->name() + ": " + to_string(turns_) + " turns, "
+        + to_string(cancelled_turns_) + " cancelled, " + to_string(static_cast<long>(turns_ > 0 ? total_us_ / turns_ : 0.0)) + " us/turn, agreement "
+        + rate + " over " + to_string(compared_) + " ship moves, live x shadow";
+    static const char moves[] = "nsewo";
+    for (int live = 0; live < 5; ++live) {
+        text += string(" ") + moves[live] + "=";
+        for (int shadow = 0; shadow < 5; ++shadow) text += (shadow ? "/" : "") + to_string(confusion_[live][shadow]);
+    }
+    return text;
+}
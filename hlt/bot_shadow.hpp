@@ -0,0 +1,151 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+#include "bot_policy.hpp"
+#include "bot_precompute.hpp"
+#include "bot_ship_memory.hpp"
+#include "bot_territory.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// What a shadow policy sees of a turn. The game and the per-turn analyses are
+// shared with the live policy and read-only while the shadow runs; the grids
+// the live ship loop writes to are copies.
+struct ShadowTurn {
+    const Game* game = nullptr;
+    const StartupTables* tables = nullptr;
+    const vector<vector<bool>>* inspired = nullptr;
+    const CellGrid<float>* risk_map = nullptr;
+    const TerritoryField* territory = nullptr;  // null when USE_TERRITORY is off
+
+    // Copies taken when the live ship loop starts
+    CellGrid<uint8_t> next_turn_occupied;
+    vector<pair<EntityId, ShipState>> status;   // sorted by id
+    vector<EntityId> decided;                   // ships the live policy already moved (skirmish), sorted
+
+    std::chrono::steady_clock::time_point deadline;
+    const std::atomic<bool>* cancel = nullptr;
+
+    // Stop as soon as possible: cancelled by the game thread, or past the deadline
+    bool cancelled() const { return cancel->load(std::memory_order_relaxed) || std::chrono::steady_clock::now() > deadline; }
+    bool is_decided(EntityId id) const;
+    ShipState status_of(EntityId id) const;
+};
+
+// An alternate strategy run next to the live one, whose moves are compared but never sent
+class ShadowPolicy {
+public:
+    virtual ~ShadowPolicy() = default;
+    virtual const char* name() const = 0;
+    virtual void reserve(size_t ships) = 0;
+    // Moves of the ships it has an opinion on; return early once turn.cancelled()
+    virtual void play(ShadowTurn& turn, vector<pair<EntityId, Direction>>& moves) = 0;
+};
+
+// The learned move policy (see bot_policy) for exploring ships, with the live
+// loop's move cost and reservation rules
+class LearnedShadowPolicy : public ShadowPolicy {
+public:
+    // False when the weights file is missing or malformed
+    bool load(const string& path) { return policy_.load(path); }
+    const char* name() const override { return "learned"; }
+    void reserve(size_t ships) override { policy_.reserve(ships); }
+    void play(ShadowTurn& turn, vector<pair<EntityId, Direction>>& moves) override;
+
+private:
+    MovePolicy policy_;
+};
+
+// Runs a shadow policy on its own thread during the live ship loop.
+//
+// start() copies the inputs the live loop is about to modify and wakes the
+// worker; finish() waits for it until the deadline, cancels it past that, then
+// diffs its moves with the live commands. The game must not change between the
+// two, so finish() always returns with the worker idle.
+//
+// The worker starts with the constants of the thread that built the runner.
+// Shadow policies must not log (the log sink is per thread) nor throw.
+class ShadowRunner {
+public:
+    explicit ShadowRunner(unique_ptr<ShadowPolicy> policy);
+    ~ShadowRunner();
+
+    ShadowRunner(const ShadowRunner&) = delete;
+    ShadowRunner& operator=(const ShadowRunner&) = delete;
+
+    const char* name() const { return policy_->name(); }
+    void reserve(size_t ships);
+
+    void start(
+        const Game& game,
+        const StartupTables& tables,
+        const vector<vector<bool>>& inspired,
+        const CellGrid<float>& risk_map,
+        const TerritoryField* territory,
+        const CellGrid<uint8_t>& next_turn_occupied,
+        const ShipMemory& mem,
+        const vector<pair<EntityId, Direction>>& decided,
+        std::chrono::steady_clock::time_point deadline
+    );
+
+    // mem: ship states once the live loop has updated them
+    void finish(const vector<Command>& live_commands, const ShipMemory& mem);
+
+    // Last turn: ships both policies moved, and how many of them the same way
+    int last_compared() const { return last_compared_; }
+    int last_agreed() const { return last_agreed_; }
+    bool last_cancelled() const { return last_cancelled_; }
+    // "<id>:<live><shadow> ..." for the ships the policies disagreed on last turn
+    const string& last_disagreements() const { return last_disagreements_; }
+
+    // "shadow <name>: <turns> turns, <cancelled> cancelled, agreement .. , live x shadow moves ..."
+    string summary() const;
+
+private:
+    void run();
+
+    unique_ptr<ShadowPolicy> policy_;
+    ShadowTurn turn_;
+    vector<pair<EntityId, Direction>> moves_;
+    vector<pair<EntityId, char>> live_;
+    std::atomic<bool> cancel_;
+    constants::Snapshot constants_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    bool pending_ = false;
+    bool busy_ = false;
+    bool stop_ = false;
+
+    int turns_ = 0;
+    int cancelled_turns_ = 0;
+    long compared_ = 0;
+    long agreed_ = 0;
+    double total_us_ = 0.0;
+    array<array<long, 5>, 5> confusion_;  // [live move][shadow move], N S E W STILL
+    int last_compared_ = 0;
+    int last_agreed_ = 0;
+    bool last_cancelled_ = false;
+    string last_disagreements_;
+    std::chrono::steady_clock::time_point started_;
+
+    // Started once every other member is constructed
+    std::thread worker_;
+};
@@ -1,5 +1,10 @@
 #include "bot_ship_memory.hpp"
 
+void ShipMemory::reserve(size_t ships) {
+    reserve_pooled(ship_status, ships);
+    reserve_pooled(ship_target, ships);
+}
+
 void ShipMemory::cleanup_dead_ships(const shared_ptr<Player>& me) {
     // Cleanup: remove entries for ships that have been destroyed
     for (auto status = ship_status.begin();
@@ -3,8 +3,7 @@
 #include "game.hpp"
 #include "constants.hpp"
 #include "log.hpp"
-
-#include <unordered_map>
+#include "fixed_containers.hpp"
 
 using namespace std;
 using namespace hlt;
@@ -16,10 +15,11 @@ enum class ShipState {
 
 struct ShipMemory {
     // Map to memorize the state of each ship between turns
-    unordered_map<EntityId, ShipState> ship_status;
+    EntityMap<ShipState> ship_status;
     // Map to memorize a mining target for each ship between turns
-    unordered_map<EntityId, Position> ship_target;
+    EntityMap<Position> ship_target;
 
+    void reserve(size_t ships);
     void cleanup_dead_ships(const shared_ptr<Player>& me);
     void ensure_initialized(const shared_ptr<Ship>& ship);
 };
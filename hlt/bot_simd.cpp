@@ -0,0 +1,494 @@
+#include "bot_simd.hpp"
+
+#include "bot_mining.hpp"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+# define BOT_SIMD_X86 1
+# include <immintrin.h>
+# if defined(_MSC_VER)
+#  include <intrin.h>
+# endif
+#endif
+
+#if defined(BOT_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+# define BOT_TARGET_SSE41 __attribute__((target("sse4.1")))
+# define BOT_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+# define BOT_TARGET_SSE41
+# define BOT_TARGET_AVX2
+#endif
+
+// ---------------------------------------------------------------------------
+// Padded grids
+
+void PaddedGrid::resize(int w, int h, int p) {
+    width = w;
+    height = h;
+    pad = p;
+    stride = w + 2 * p + SIMD_ROW_SLACK;
+    data.assign(static_cast<size_t>(h + 2 * p) * stride, 0);
+}
+
+void PaddedGrid::set(int x, int y, int32_t value) {
+    // A core cell has up to 2 copies per axis (itself and one wrapped alias)
+    int xs[2] = { x, x < pad ? x + width : (x >= width - pad ? x - width : x) };
+    int ys[2] = { y, y < pad ? y + height : (y >= height - pad ? y - height : y) };
+    for (int j = 0; j < 2; ++j) {
+        for (int i = 0; i < 2; ++i) {
+            row(ys[j])[xs[i]] = value;
+        }
+    }
+}
+
+void PaddedGrid::refresh_padding() {
+    for (int y = 0; y < height; ++y) {
+        int32_t* r = row(y);
+        for (int x = -pad; x < 0; ++x) r[x] = r[x + width];
+        for (int x = width; x < width + pad; ++x) r[x] = r[x - width];
+    }
+    for (int y = -pad; y < 0; ++y) {
+        std::copy(row(y + height) - pad, row(y + height) + width + pad, row(y) - pad);
+    }
+    for (int y = height; y < height + pad; ++y) {
+        std::copy(row(y - height) - pad, row(y - height) + width + pad, row(y) - pad);
+    }
+}
+
+void PaddedGrid::fold_padding() {
+    // Top / bottom padding rows first (including their corners), then left / right columns
+    for (int y = -pad; y < 0; ++y) {
+        int32_t* src = row(y);
+        int32_t* dst = row(y + height);
+        for (int x = -pad; x < width + pad; ++x) dst[x] += src[x];
+    }
+    for (int y = height; y < height + pad; ++y) {
+        int32_t* src = row(y);
+        int32_t* dst = row(y - height);
+        for (int x = -pad; x < width + pad; ++x) dst[x] += src[x];
+    }
+    for (int y = 0; y < height; ++y) {
+        int32_t* r = row(y);
+        for (int x = -pad; x < 0; ++x) r[x + width] += r[x];
+        for (int x = width; x < width + pad; ++x) r[x - width] += r[x];
+    }
+    refresh_padding();
+}
+
+void PaddedGrid::fill(int32_t value) {
+    std::fill(data.begin(), data.end(), value);
+}
+
+void WindowWeights::build(int r) {
+    radius = r;
+    int span = 2 * r + 1;
+    row_stride = (span + 7) / 8 * 8;
+    weight.assign(static_cast<size_t>(span) * row_stride, 0);
+    for (int dy = -r; dy <= r; ++dy) {
+        for (int dx = -r; dx <= r; ++dx) {
+            int d = std::abs(dx) + std::abs(dy);
+            weight[(dy + r) * row_stride + (dx + r)] = (32768 + (d + 1) / 2) / (d + 1);
+        }
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Scalar kernels (reference and fallback)
+
+static int64_t window_sum_scalar(const PaddedGrid& grid, int cx, int cy, int radius) {
+    int64_t total = 0;
+    for (int y = cy - radius; y <= cy + radius; ++y) {
+        const int32_t* r = grid.row(y);
+        for (int x = cx - radius; x <= cx + radius; ++x) total += r[x];
+    }
+    return total;
+}
+
+static void diamond_add_scalar(PaddedGrid& grid, int cx, int cy, int radius) {
+    for (int dy = -radius; dy <= radius; ++dy) {
+        int rem = radius - std::abs(dy);
+        int32_t* r = grid.row(cy + dy);
+        for (int x = cx - rem; x <= cx + rem; ++x) ++r[x];
+    }
+}
+
+static void score_row_scalar(
+    const int32_t* halite,
+    const int32_t* multiplier,
+    const int32_t* claim_shift,
+    const int32_t* weight,
+    int n,
+    int32_t min_halite,
+    int32_t* out
+) {
+    for (int i = 0; i < n; ++i) {
+        int32_t eff = std::min(halite[i] * multiplier[i], 65535);
+        if (halite[i] < min_halite) eff >>= 2;
+        out[i] = static_cast<int32_t>(static_cast<uint32_t>(eff * weight[i]) >> claim_shift[i]);
+    }
+}
+
+static void decay_step_scalar(float* carry, const float* in, int n, float a) {
+    for (int i = 0; i < n; ++i) carry[i] = in[i] + a * carry[i];
+}
+
+static void decay_accumulate_scalar(float* out, float* carry, const float* in, int n, float a) {
+    for (int i = 0; i < n; ++i) {
+        out[i] += a * carry[i];
+        carry[i] = in[i] + a * carry[i];
+    }
+}
+
+static void axpy_scalar(float* out, const float* in, int n, float a) {
+    for (int i = 0; i < n; ++i) out[i] += a * in[i];
+}
+
+static const SimdKernels SCALAR_KERNELS = {
+    "scalar", window_sum_scalar, diamond_add_scalar, score_row_scalar, decay_step_scalar, decay_accumulate_scalar, axpy_scalar
+};
+
+#ifdef BOT_SIMD_X86
+
+// ---------------------------------------------------------------------------
+// SSE4.1 kernels (4 lanes)
+
+BOT_TARGET_SSE41 static int64_t hsum_epi32_sse(__m128i v) {
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_cvtsi128_si32(v);
+}
+
+BOT_TARGET_SSE41 static int64_t window_sum_sse41(const PaddedGrid& grid, int cx, int cy, int radius) {
+    int span = 2 * radius + 1;
+    int64_t total = 0;
+    for (int y = cy - radius; y <= cy + radius; ++y) {
+        const int32_t* r = grid.row(y) + cx - radius;
+        __m128i acc = _mm_setzero_si128();
+        int i = 0;
+        for (; i + 4 <= span; i += 4) {
+            acc = _mm_add_epi32(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(r + i)));
+        }
+        total += hsum_epi32_sse(acc);
+        for (; i < span; ++i) total += r[i];
+    }
+    return total;
+}
+
+BOT_TARGET_SSE41 static void diamond_add_sse41(PaddedGrid& grid, int cx, int cy, int radius) {
+    const __m128i one = _mm_set1_epi32(1);
+    for (int dy = -radius; dy <= radius; ++dy) {
+        int rem = radius - std::abs(dy);
+        int span = 2 * rem + 1;
+        int32_t* r = grid.row(cy + dy) + cx - rem;
+        int i = 0;
+        for (; i + 4 <= span; i += 4) {
+            __m128i* p = reinterpret_cast<__m128i*>(r + i);
+            _mm_storeu_si128(p, _mm_add_epi32(_mm_loadu_si128(p), one));
+        }
+        for (; i < span; ++i) ++r[i];
+    }
+}
+
+// v >> count per lane (counts 0..31): one shift and blend per bit of the count, the bit
+// moved to the sign position that blendv_ps selects on
+BOT_TARGET_SSE41 static __m128i srl_bit_sse41(__m128i v, __m128i count, int bit) {
+    __m128 shifted = _mm_castsi128_ps(_mm_srl_epi32(v, _mm_cvtsi32_si128(1 << bit)));
+    __m128 select = _mm_castsi128_ps(_mm_slli_epi32(count, 31 - bit));
+    return _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(v), shifted, select));
+}
+
+BOT_TARGET_SSE41 static __m128i srlv_epi32_sse41(__m128i v, __m128i count) {
+    v = srl_bit_sse41(v, count, 0);
+    v = srl_bit_sse41(v, count, 1);
+    v = srl_bit_sse41(v, count, 2);
+    v = srl_bit_sse41(v, count, 3);
+    return srl_bit_sse41(v, count, 4);
+}
+
+BOT_TARGET_SSE41 static void score_row_sse41(
+    const int32_t* halite,
+    const int32_t* multiplier,
+    const int32_t* claim_shift,
+    const int32_t* weight,
+    int n,
+    int32_t min_halite,
+    int32_t* out
+) {
+    const __m128i cap = _mm_set1_epi32(65535);
+    const __m128i min_h = _mm_set1_epi32(min_halite);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(halite + i));
+        __m128i m = _mm_loadu_si128(reinterpret_cast<const __m128i*>(multiplier + i));
+        __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(claim_shift + i));
+        __m128i w = _mm_loadu_si128(reinterpret_cast<const __m128i*>(weight + i));
+
+        __m128i eff = _mm_min_epi32(_mm_mullo_epi32(h, m), cap);
+        eff = _mm_blendv_epi8(eff, _mm_srli_epi32(eff, 2), _mm_cmpgt_epi32(min_h, h));
+        __m128i s = srlv_epi32_sse41(_mm_mullo_epi32(eff, w), c);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), s);
+    }
+    score_row_scalar(halite + i, multiplier + i, claim_shift + i, weight + i, n - i, min_halite, out + i);
+}
+
+BOT_TARGET_SSE41 static void decay_step_sse41(float* carry, const float* in, int n, float a) {
+    __m128 av = _mm_set1_ps(a);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 c = _mm_loadu_ps(carry + i);
+        _mm_storeu_ps(carry + i, _mm_add_ps(_mm_loadu_ps(in + i), _mm_mul_ps(av, c)));
+    }
+    decay_step_scalar(carry + i, in + i, n - i, a);
+}
+
+BOT_TARGET_SSE41 static void decay_accumulate_sse41(float* out, float* carry, const float* in, int n, float a) {
+    __m128 av = _mm_set1_ps(a);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 c = _mm_mul_ps(av, _mm_loadu_ps(carry + i));
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), c));
+        _mm_storeu_ps(carry + i, _mm_add_ps(_mm_loadu_ps(in + i), c));
+    }
+    decay_accumulate_scalar(out + i, carry + i, in + i, n - i, a);
+}
+
+BOT_TARGET_SSE41 static void axpy_sse41(float* out, const float* in, int n, float a) {
+    __m128 av = _mm_set1_ps(a);
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(av, _mm_loadu_ps(in + i))));
+    }
+    axpy_scalar(out + i, in + i, n - i, a);
+}
+
+static const SimdKernels SSE41_KERNELS = {
+    "sse4.1", window_sum_sse41, diamond_add_sse41, score_row_sse41, decay_step_sse41, decay_accumulate_sse41, axpy_sse41
+};
+
+// ---------------------------------------------------------------------------
+// AVX2 kernels (8 lanes)
+
+BOT_TARGET_AVX2 static int64_t window_sum_avx2(const PaddedGrid& grid, int cx, int cy, int radius) {
+    int span = 2 * radius + 1;
+    int64_t total = 0;
+    __m256i acc = _mm256_setzero_si256();
+    for (int y = cy - radius; y <= cy + radius; ++y) {
+        const int32_t* r = grid.row(y) + cx - radius;
+        int i = 0;
+        for (; i + 8 <= span; i += 8) {
+            acc = _mm256_add_epi32(acc, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(r + i)));
+        }
+        for (; i < span; ++i) total += r[i];
+    }
+    __m128i v = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+    v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+    return total + _mm_cvtsi128_si32(v);
+}
+
+BOT_TARGET_AVX2 static void diamond_add_avx2(PaddedGrid& grid, int cx, int cy, int radius) {
+    const __m256i one = _mm256_set1_epi32(1);
+    for (int dy = -radius; dy <= radius; ++dy) {
+        int rem = radius - std::abs(dy);
+        int span = 2 * rem + 1;
+        int32_t* r = grid.row(cy + dy) + cx - rem;
+        int i = 0;
+        for (; i + 8 <= span; i += 8) {
+            __m256i* p = reinterpret_cast<__m256i*>(r + i);
+            _mm256_storeu_si256(p, _mm256_add_epi32(_mm256_loadu_si256(p), one));
+        }
+        for (; i < span; ++i) ++r[i];
+    }
+}
+
+BOT_TARGET_AVX2 static void score_row_avx2(
+    const int32_t* halite,
+    const int32_t* multiplier,
+    const int32_t* claim_shift,
+    const int32_t* weight,
+    int n,
+    int32_t min_halite,
+    int32_t* out
+) {
+    const __m256i cap = _mm256_set1_epi32(65535);
+    const __m256i min_h = _mm256_set1_epi32(min_halite);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256i h = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(halite + i));
+        __m256i m = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(multiplier + i));
+        __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(claim_shift + i));
+        __m256i w = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(weight + i));
+
+        __m256i eff = _mm256_min_epi32(_mm256_mullo_epi32(h, m), cap);
+        eff = _mm256_blendv_epi8(eff, _mm256_srli_epi32(eff, 2), _mm256_cmpgt_epi32(min_h, h));
+        __m256i s = _mm256_srlv_epi32(_mm256_mullo_epi32(eff, w), c);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), s);
+    }
+    score_row_scalar(halite + i, multiplier + i, claim_shift + i, weight + i, n - i, min_halite, out + i);
+}
+
+BOT_TARGET_AVX2 static void decay_step_avx2(float* carry, const float* in, int n, float a) {
+    __m256 av = _mm256_set1_ps(a);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 c = _mm256_loadu_ps(carry + i);
+        _mm256_storeu_ps(carry + i, _mm256_add_ps(_mm256_loadu_ps(in + i), _mm256_mul_ps(av, c)));
+    }
+    decay_step_scalar(carry + i, in + i, n - i, a);
+}
+
+BOT_TARGET_AVX2 static void decay_accumulate_avx2(float* out, float* carry, const float* in, int n, float a) {
+    __m256 av = _mm256_set1_ps(a);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 c = _mm256_mul_ps(av, _mm256_loadu_ps(carry + i));
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), c));
+        _mm256_storeu_ps(carry + i, _mm256_add_ps(_mm256_loadu_ps(in + i), c));
+    }
+    decay_accumulate_scalar(out + i, carry + i, in + i, n - i, a);
+}
+
+BOT_TARGET_AVX2 static void axpy_avx2(float* out, const float* in, int n, float a) {
+    __m256 av = _mm256_set1_ps(a);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_add_ps(_mm256_loadu_ps(out + i), _mm256_mul_ps(av, _mm256_loadu_ps(in + i))));
+    }
+    axpy_scalar(out + i, in + i, n - i, a);
+}
+
+static const SimdKernels AVX2_KERNELS = {
+    "avx2", window_sum_avx2, diamond_add_avx2, score_row_avx2, decay_step_avx2, decay_accumulate_avx2, axpy_avx2
+};
+
+static bool cpu_supports(SimdLevel level) {
+#if defined(__GNUC__) || defined(__clang__)
+    __builtin_cpu_init();
+    if (level == SimdLevel::AVX2) return __builtin_cpu_supports("avx2");
+    if (level == SimdLevel::SSE41) return __builtin_cpu_supports("sse4.1");
+    return true;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool os_avx = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    if (level == SimdLevel::SSE41) return sse41;
+    if (level == SimdLevel::AVX2) {
+        __cpuidex(info, 7, 0);
+        return os_avx && (info[1] & (1 << 5)) != 0;
+    }
+    return true;
+#else
+    return level == SimdLevel::SCALAR;
+#endif
+}
+
+#endif // BOT_SIMD_X86
+
+const SimdKernels* simd_kernels_for(SimdLevel level) {
+#ifdef BOT_SIMD_X86
+    if (!cpu_supports(level)) return nullptr;
+    switch (level) {
+        case SimdLevel::AVX2: return &AVX2_KERNELS;
+        case SimdLevel::SSE41: return &SSE41_KERNELS;
+        case SimdLevel::SCALAR: return &SCALAR_KERNELS;
+    }
+    return nullptr;
+#else
+    return level == SimdLevel::SCALAR ? &SCALAR_KERNELS : nullptr;
+#endif
+}
+
+static const SimdKernels* detect_best_kernels() {
+    const SimdKernels* best = simd_kernels_for(SimdLevel::AVX2);
+    if (!best) best = simd_kernels_for(SimdLevel::SSE41);
+    if (!best) best = &SCALAR_KERNELS;
+    log::log(string("simd: using ") + best->name + " kernels");
+    return best;
+}
+
+const SimdKernels& simd_kernels() {
+    // Static init is thread-safe: hosted games may hit this concurrently
+    static const SimdKernels* best = detect_best_kernels();
+    return *best;
+}
+
+// ---------------------------------------------------------------------------
+// Mining target scan
+
+void MiningGrids::update(GameMap* game_map_ptr, const vector<vector<bool>>& inspired, const vector<vector<bool>>& claimed_targets) {
+    int w = game_map_ptr->width;
+    int h = game_map_ptr->height;
+
+    if (halite.width != w || halite.height != h) {
+        halite.resize(w, h, SEARCH_RADIUS);
+        multiplier.resize(w, h, SEARCH_RADIUS);
+        claim_shift.resize(w, h, SEARCH_RADIUS);
+        weights.build(SEARCH_RADIUS);
+
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) halite.row(y)[x] = game_map_ptr->cells[y][x].halite;
+        }
+        halite.refresh_padding();
+    }
+    else {
+        // Only the cells the engine reported this turn
+        for (const auto& pos : game_map_ptr->changed_cells) {
+            halite.set(pos.x, pos.y, game_map_ptr->cells[pos.y][pos.x].halite);
+        }
+    }
+
+    for (int y = 0; y < h; ++y) {
+        int32_t* m = multiplier.row(y);
+        int32_t* c = claim_shift.row(y);
+        for (int x = 0; x < w; ++x) {
+            m[x] = inspired[y][x] ? INSPIRED_MULTIPLIER : 1;
+            c[x] = claimed_targets[y][x] ? CLAIM_SCORE_SHIFT : 0;
+        }
+    }
+    multiplier.refresh_padding();
+    claim_shift.refresh_padding();
+}
+
+Position scan_mining_window(const SimdKernels& kernels, const MiningGrids& grids, const Position& origin) {
+    const WindowWeights& weights = grids.weights;
+    int r = weights.radius;
+    int span = 2 * r + 1;
+
+    int32_t scores[(2 * SEARCH_RADIUS + 1) * ((2 * SEARCH_RADIUS + 1 + 7) / 8 * 8)];
+
+    for (int dy = -r; dy <= r; ++dy) {
+        int y = origin.y + dy;
+        int x0 = origin.x - r;
+        int offset = (dy + r) * weights.row_stride;
+        kernels.score_row(
+            grids.halite.row(y) + x0,
+            grids.multiplier.row(y) + x0,
+            grids.claim_shift.row(y) + x0,
+            &weights.weight[offset],
+            weights.row_stride,
+            MIN_TARGET_HALITE,
+            scores + offset
+        );
+    }
+
+    // First maximum in scan order, like the scalar scan
+    int best_score = -1;
+    int best_dx = 0;
+    int best_dy = 0;
+    for (int j = 0; j < span; ++j) {
+        const int32_t* row_scores = scores + j * weights.row_stride;
+        for (int i = 0; i < span; ++i) {
+            if (row_scores[i] > best_score) {
+                best_score = row_scores[i];
+                best_dx = i - r;
+                best_dy = j - r;
+            }
+        }
+    }
+
+    int w = grids.halite.width;
+    int h = grids.halite.height;
+    return Position(((origin.x + best_dx) % w + w) % w, ((origin.y + best_dy) % h + h) % h);
+}
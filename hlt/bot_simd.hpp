@@ -0,0 +1,118 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Extra columns at the end of every padded row (one AVX2 vector)
+static const int SIMD_ROW_SLACK = 8;
+
+// Grid of int32 with `pad` wrap-extended cells on every side, so that any
+// window of radius <= pad around a core cell is a set of contiguous row spans.
+// Rows carry SIMD_ROW_SLACK extra columns on the right so kernels can read
+// whole vectors past the end of a span.
+struct PaddedGrid {
+    int width = 0;
+    int height = 0;
+    int pad = 0;
+    int stride = 0;
+    vector<int32_t> data;
+
+    void resize(int w, int h, int p);
+
+    // Row y (-pad <= y < height + pad), indexed by x (-pad <= x < width + pad)
+    int32_t* row(int y) { return &data[static_cast<size_t>(y + pad) * stride + pad]; }
+    const int32_t* row(int y) const { return &data[static_cast<size_t>(y + pad) * stride + pad]; }
+
+    int32_t get(int x, int y) const { return row(y)[x]; }
+
+    // Write a core cell and every wrapped copy of it in the padding
+    void set(int x, int y, int32_t value);
+
+    // Copy core cells into the padding (after writing the core directly)
+    void refresh_padding();
+
+    // Add padding cells back onto the core cells they alias, then refresh the padding
+    // (after kernels accumulated into padded spans)
+    void fold_padding();
+
+    void fill(int32_t value);
+};
+
+// Fixed-point reciprocal distance weights of a scoring window: weight[(dy + r) * row_stride + (dx + r)]
+// is round(2^15 / (|dx| + |dy| + 1)), lanes past the window are 0
+struct WindowWeights {
+    int radius = 0;
+    int row_stride = 0;
+    vector<int32_t> weight;
+
+    void build(int r);
+};
+
+// One implementation of every kernel; chosen once at runtime
+struct SimdKernels {
+    const char* name;
+
+    // Sum of the (2 * radius + 1)^2 square around (cx, cy), radius <= grid.pad
+    int64_t (*window_sum)(const PaddedGrid& grid, int cx, int cy, int radius);
+
+    // +1 on every cell within manhattan radius of (cx, cy), written into padded spans
+    // (call fold_padding once all stamps are done)
+    void (*diamond_add)(PaddedGrid& grid, int cx, int cy, int radius);
+
+    // out[i] = (min(h * mult, 65535) >> (h < min_halite ? 2 : 0)) * weight >> claim_shift (any of 0..31), for n lanes
+    void (*score_row)(
+        const int32_t* halite,
+        const int32_t* multiplier,
+        const int32_t* claim_shift,
+        const int32_t* weight,
+        int n,
+        int32_t min_halite,
+        int32_t* out
+    );
+
+    // carry[i] = in[i] + a * carry[i], for n lanes (one step of a recursive decay filter)
+    void (*decay_step)(float* carry, const float* in, int n, float a);
+
+    // out[i] += a * carry[i], then the decay_step, for n lanes
+    void (*decay_accumulate)(float* out, float* carry, const float* in, int n, float a);
+
+    // out[i] += a * in[i], for n lanes
+    void (*axpy)(float* out, const float* in, int n, float a);
+};
+
+enum class SimdLevel {
+    SCALAR,
+    SSE41,
+    AVX2
+};
+
+// Best kernels supported by this CPU (detected on first call)
+const SimdKernels& simd_kernels();
+
+// Kernels of a given level, or nullptr if the CPU / build does not support it
+const SimdKernels* simd_kernels_for(SimdLevel level);
+
+// Per-turn inputs of the SIMD target scan
+struct MiningGrids {
+    PaddedGrid halite;
+    PaddedGrid multiplier;   // INSPIRED_MULTIPLIER on inspired cells, 1 elsewhere
+    PaddedGrid claim_shift;  // CLAIM_SCORE_SHIFT on claimed cells, TERRITORY_SCORE_SHIFT on enemy territory, 0 elsewhere
+    WindowWeights weights;
+
+    // Sync halite (full on first call, then from game_map->changed_cells), inspiration and claims
+    void update(GameMap* game_map_ptr, const vector<vector<bool>>& inspired, const vector<vector<bool>>& claimed_targets);
+
+    void claim(const Position& pos) { claim_shift.set(pos.x, pos.y, CLAIM_SCORE_SHIFT); }
+};
+
+// Best target in the SEARCH_RADIUS window around origin, scored by the fixed-point kernel
+Position scan_mining_window(const SimdKernels& kernels, const MiningGrids& grids, const Position& origin);
@@ -0,0 +1,271 @@
+#include "bot_skirmish.hpp"
+
+#include <algorithm>
+#include <limits>
+
+using Clock = std::chrono::steady_clock;
+
+static const double NOT_ALLOWED = -std::numeric_limits<double>::infinity();
+
+void SkirmishSolver::reserve(size_t ships, int cells) {
+    cells_ = cells;
+    our_at_.assign(cells, -1);
+    their_at_.assign(cells, -1);
+    our_cluster_.reserve(ships);
+    their_cluster_.reserve(ships * 4);
+    our_cells_.reserve(ships);
+    their_cells_.reserve(ships * 4);
+    our_halite_.reserve(ships);
+    our_ids_.reserve(ships);
+    their_ships_.reserve(ships * 4);
+    deposits_.reserve(ships * 4);
+    moves_.reserve(ships);
+    ours_.reserve(SKIRMISH_MAX_OURS);
+    theirs_.reserve(SKIRMISH_MAX_THEIRS);
+    their_index_.reserve(SKIRMISH_MAX_THEIRS);
+}
+
+bool SkirmishSolver::has_move(EntityId id) const {
+    auto it = std::lower_bound(moves_.begin(), moves_.end(), id,
+        [](const pair<EntityId, Direction>& move, EntityId key) { return move.first < key; });
+    return it != moves_.end() && it->first == id;
+}
+
+void SkirmishSolver::solve(const Game& game, const EnemyTracker& tracker, const StartupTables& tables,
+    const TerritoryField* territory, double ship_value) {
+    moves_.clear();
+    const CellTopology& geometry = *tables.geometry;
+    int cells = geometry.cell_count();
+    if (cells_ != cells) reserve(game.me->ships.size(), cells);
+
+    // Index both fleets by cell, and every deposit (halite dropped there goes to its owner)
+    our_cells_.clear();
+    our_halite_.clear();
+    our_ids_.clear();
+    for (const auto& ship_pair : game.me->ships) {
+        const Ship& ship = *ship_pair.second;
+        CellId c = geometry.id(ship.position);
+        our_at_[c] = static_cast<int16_t>(our_cells_.size());
+        our_cells_.push_back(c);
+        our_halite_.push_back(ship.halite);
+        our_ids_.push_back(ship.id);
+    }
+    their_cells_.clear();
+    their_ships_.clear();
+    deposits_.clear();
+    for (const auto& player_ptr : game.players) {
+        PlayerId owner = player_ptr->id;
+        deposits_.emplace_back(geometry.id(player_ptr->shipyard->position), owner);
+        for (const auto& dropoff_pair : player_ptr->dropoffs) {
+            const Position& p = dropoff_pair.second->position;
+            deposits_.emplace_back(geometry.id(p), owner);
+        }
+        if (owner == game.my_id) continue;
+        for (const auto& ship_pair : player_ptr->ships) {
+            const Ship& ship = *ship_pair.second;
+            CellId c = geometry.id(ship.position);
+            their_at_[c] = static_cast<int16_t>(their_cells_.size());
+            their_cells_.push_back(c);
+            their_ships_.push_back(&ship);
+        }
+    }
+    our_cluster_.assign(our_cells_.size(), -1);
+    their_cluster_.assign(their_cells_.size(), -1);
+
+    my_id_ = game.my_id;
+    enemy_weight_ = game.players.size() > 2 ? 1.0 / (game.players.size() - 1) : 1.0;
+    cluster_ = 0;
+    for (int seed = 0; seed < static_cast<int>(our_cells_.size()); ++seed) {
+        if (our_cluster_[seed] >= 0) continue;
+        build_cluster(seed, geometry);
+        if (theirs_.empty()) continue;
+        ++clusters_;
+
+        Clock::time_point start = Clock::now();
+        deadline_ = start + std::chrono::microseconds(SKIRMISH_BUDGET_US);
+        score_cluster(game, tracker, tables, territory, ship_value);
+
+        // Only joint moves worth SKIRMISH_MIN_GAIN are kept: it is the search's starting bound
+        best_score_ = SKIRMISH_MIN_GAIN;
+        found_ = false;
+        nodes_ = 0;
+        timed_out_ = false;
+        search(0, 0.0);
+        if (timed_out_) ++timeouts_;
+        if (!found_) continue;
+        ++engagements_;
+
+        // The ships that engage, then any ship whose cell one of them moves into
+        int n = static_cast<int>(ours_.size());
+        array<bool, SKIRMISH_MAX_OURS> emit;
+        for (int i = 0; i < n; ++i) emit[i] = ours_[i].reach[best_choice_[i]] > 0.0;
+        for (bool grew = true; grew; ) {
+            grew = false;
+            for (int i = 0; i < n; ++i) {
+                if (emit[i]) continue;
+                for (int j = 0; j < n; ++j) {
+                    if (emit[j] && ours_[j].dest[best_choice_[j]] == ours_[i].cell) {
+                        emit[i] = grew = true;
+                        break;
+                    }
+                }
+            }
+        }
+        for (int i = 0; i < n; ++i) {
+            if (!emit[i]) continue;
+            int k = best_choice_[i];
+            moves_.emplace_back(ours_[i].id, k == NEIGHBOUR_STILL ? Direction::STILL : ALL_CARDINALS[k]);
+        }
+    }
+    std::sort(moves_.begin(), moves_.end(),
+        [](const pair<EntityId, Direction>& a, const pair<EntityId, Direction>& b) { return a.first < b.first; });
+
+    for (CellId c : our_cells_) our_at_[c] = -1;
+    for (CellId c : their_cells_) their_at_[c] = -1;
+}
+
+void SkirmishSolver::build_cluster(int seed, const CellTopology& geometry) {
+    ours_.clear();
+    theirs_.clear();
+    their_index_.clear();
+
+    // Breadth first over "within 2 moves", alternating sides, until either side is full
+    our_cluster_[seed] = static_cast<int16_t>(cluster_);
+    OurShip first;
+    first.index = seed;
+    ours_.push_back(first);
+    size_t our_head = 0;
+    size_t their_head = 0;
+    while (our_head < ours_.size() || their_head < their_index_.size()) {
+        if (our_head < ours_.size()) {
+            CellId c = our_cells_[ours_[our_head++].index];
+            for (int k1 = 0; k1 < NEIGHBOUR_SLOTS; ++k1) {
+                CellId c1 = geometry.neighbour(c, k1);
+                for (int k2 = 0; k2 < NEIGHBOUR_SLOTS; ++k2) {
+                    int j = their_at_[geometry.neighbour(c1, k2)];
+                    if (j < 0 || their_cluster_[j] >= 0 || their_index_.size() >= static_cast<size_t>(SKIRMISH_MAX_THEIRS)) continue;
+                    their_cluster_[j] = static_cast<int16_t>(cluster_);
+                    their_index_.push_back(j);
+                }
+            }
+        }
+        if (their_head < their_index_.size()) {
+            CellId c = their_cells_[their_index_[their_head++]];
+            for (int k1 = 0; k1 < NEIGHBOUR_SLOTS; ++k1) {
+                CellId c1 = geometry.neighbour(c, k1);
+                for (int k2 = 0; k2 < NEIGHBOUR_SLOTS; ++k2) {
+                    int i = our_at_[geometry.neighbour(c1, k2)];
+                    if (i < 0 || our_cluster_[i] >= 0 || ours_.size() >= static_cast<size_t>(SKIRMISH_MAX_OURS)) continue;
+                    our_cluster_[i] = static_cast<int16_t>(cluster_);
+                    OurShip ship;
+                    ship.index = i;
+                    ours_.push_back(ship);
+                }
+            }
+        }
+    }
+    for (int j : their_index_) {
+        TheirShip ship;
+        ship.index = j;
+        theirs_.push_back(ship);
+    }
+    ++cluster_;
+}
+
+void SkirmishSolver::score_cluster(const Game& game, const EnemyTracker& tracker, const StartupTables& tables,
+    const TerritoryField* territory, double ship_value) {
+    const CellTopology& geometry = *tables.geometry;
+    GameMap* game_map = game.game_map.get();
+
+    for (TheirShip& them : theirs_) {
+        const Ship& ship = *their_ships_[them.index];
+        them.cell = their_cells_[them.index];
+        them.halite = ship.halite;
+        tracker.move_distribution(ship, game_map, them.p);
+    }
+
+    int n = static_cast<int>(ours_.size());
+    for (int i = 0; i < n; ++i) {
+        OurShip& us = ours_[i];
+        us.id = our_ids_[us.index];
+        us.cell = our_cells_[us.index];
+        us.halite = our_halite_[us.index];
+        int cost = tables.cost_to_move(game_map->at(us.cell)->halite);
+
+        for (int k = 0; k < NEIGHBOUR_SLOTS; ++k) {
+            CellId d = geometry.neighbour(us.cell, k);
+            us.dest[k] = d;
+            us.reach[k] = 0.0;
+            us.score[k] = NOT_ALLOWED;
+
+            if (k != NEIGHBOUR_STILL && us.halite < cost) continue;
+            // A ship of ours outside the cluster may well stay on its cell
+            int ally = our_at_[d];
+            if (ally >= 0 && our_cluster_[ally] != our_cluster_[us.index]) continue;
+            // Halite dropped on a deposit goes to its owner
+            double recovered = 0.0;
+            bool enemy_deposit = false;
+            for (const auto& deposit : deposits_) {
+                if (deposit.first != d) continue;
+                if (deposit.second == my_id_) recovered = 1.0;
+                else enemy_deposit = true;
+            }
+            if (enemy_deposit) continue;
+            if (recovered == 0.0 && territory && territory->is_ours(geometry.position(d))) recovered = SKIRMISH_DROP_RECOVERY;
+
+            // Enemies land on d independently
+            double gain = 0.0;
+            double survive = 1.0;
+            for (const TheirShip& them : theirs_) {
+                double p = 0.0;
+                for (int kk = 0; kk < NEIGHBOUR_SLOTS; ++kk) {
+                    if (geometry.neighbour(them.cell, kk) == d) p += them.p[kk];
+                }
+                if (p == 0.0) continue;
+                us.reach[k] += p;
+                survive *= 1.0 - p;
+                gain += p * (enemy_weight_ * (them.halite + ship_value) + recovered * (us.halite + them.halite));
+            }
+            us.score[k] = gain - (1.0 - survive) * (us.halite + ship_value);
+        }
+
+        // Best destinations first, so that the bound prunes early
+        for (int k = 0; k < 5; ++k) us.order[k] = k;
+        std::sort(us.order.begin(), us.order.end(), [&us](int a, int b) { return us.score[a] > us.score[b]; });
+    }
+
+    // bound_[i]: best total of ships i .. n-1 ignoring that destinations must differ
+    bound_[n] = 0.0;
+    for (int i = n - 1; i >= 0; --i) bound_[i] = bound_[i + 1] + ours_[i].score[ours_[i].order[0]];
+}
+
+void SkirmishSolver::search(int depth, double score) {
+    int n = static_cast<int>(ours_.size());
+    if (depth == n) {
+        if (score > best_score_) {
+            best_score_ = score;
+            best_choice_ = choice_;
+            found_ = true;
+        }
+        return;
+    }
+    if (timed_out_ || score + bound_[depth] <= best_score_) return;
+    if ((++nodes_ & 63) == 0 && Clock::now() > deadline_) {
+        timed_out_ = true;
+        return;
+    }
+
+    const OurShip& us = ours_[depth];
+    for (int k : us.order) {
+        double s = us.score[k];
+        if (s == NOT_ALLOWED) break;
+        if (score + s + bound_[depth + 1] <= best_score_) break;
+        // Two of our ships never share a destination
+        CellId d = us.dest[k];
+        bool taken = false;
+        for (int i = 0; i < depth; ++i) taken = taken || ours_[i].dest[choice_[i]] == d;
+        if (taken) continue;
+        choice_[depth] = k;
+        search(depth + 1, score + s);
+    }
+}
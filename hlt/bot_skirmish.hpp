@@ -0,0 +1,111 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+#include "bot_enemy_tracker.hpp"
+#include "bot_precompute.hpp"
+#include "bot_territory.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Joint moves for small groups of our ships in reach of enemy ships.
+//
+// Ships interact when they are within 2 moves of each other (they can end on
+// the same cell). solve() groups interacting ships into clusters of at most
+// SKIRMISH_MAX_OURS of ours and SKIRMISH_MAX_THEIRS of theirs, then searches
+// the joint moves of our ships in each cluster, enemies moving independently
+// by the enemy tracker's model. With the enemies independent, the expected
+// outcome of a joint move is a sum over our ships: each destination scores
+// the enemy cargo (and ships) expected to sink on it, minus our own expected
+// loss, plus the dropped halite when we reach that cell first. A depth-first
+// search over distinct destinations, bounded by every remaining ship's best
+// destination, finds the best joint move within SKIRMISH_BUDGET_US.
+//
+// Only clusters whose best joint move is worth SKIRMISH_MIN_GAIN get moves,
+// and only for the ships that engage (plus any whose cell they move into);
+// everyone else keeps the normal per-ship logic.
+class SkirmishSolver {
+public:
+    void reserve(size_t ships, int cells);
+
+    // ship_value: halite a ship of ours is still expected to bring back
+    void solve(const Game& game, const EnemyTracker& tracker, const StartupTables& tables,
+        const TerritoryField* territory, double ship_value);
+
+    // Chosen moves of this turn, sorted by ship id
+    const vector<pair<EntityId, Direction>>& moves() const { return moves_; }
+    bool has_move(EntityId id) const;
+
+    int clusters() const { return clusters_; }
+    int engagements() const { return engagements_; }
+    int timeouts() const { return timeouts_; }
+
+private:
+    struct OurShip {
+        int index;                 // in the turn's fleet
+        EntityId id;
+        CellId cell;
+        int halite;
+        array<CellId, 5> dest;     // per move, NEIGHBOUR_STILL last
+        array<double, 5> score;    // -inf when the move is not allowed
+        array<double, 5> reach;    // enemy probability mass on the destination
+        array<int, 5> order;       // moves by decreasing score
+    };
+
+    struct TheirShip {
+        int index;
+        CellId cell;
+        int halite;
+        array<double, 5> p;        // P(move), NEIGHBOUR_STILL last
+    };
+
+    void build_cluster(int seed, const CellTopology& geometry);
+    void score_cluster(const Game& game, const EnemyTracker& tracker, const StartupTables& tables,
+        const TerritoryField* territory, double ship_value);
+    void search(int depth, double score);
+
+    int cells_ = 0;
+    vector<int16_t> our_at_;      // our ship index on each cell, -1 if none
+    vector<int16_t> their_at_;    // enemy ship index on each cell, -1 if none
+    vector<int16_t> our_cluster_; // cluster a ship of ours was put in, -1 if none yet
+    vector<int16_t> their_cluster_;
+    vector<CellId> our_cells_;
+    vector<CellId> their_cells_;
+    vector<int> our_halite_;
+    vector<EntityId> our_ids_;
+    vector<const Ship*> their_ships_;
+    vector<pair<CellId, PlayerId>> deposits_;
+    PlayerId my_id_ = 0;
+    double enemy_weight_ = 1.0;   // share of an enemy's loss that is our gain
+
+    // Current cluster
+    int cluster_ = 0;
+    vector<OurShip> ours_;
+    vector<TheirShip> theirs_;
+    vector<int> their_index_;
+
+    // Search state
+    array<int, SKIRMISH_MAX_OURS> choice_;
+    array<int, SKIRMISH_MAX_OURS> best_choice_;
+    array<double, SKIRMISH_MAX_OURS + 1> bound_;
+    double best_score_ = 0.0;
+    bool found_ = false;
+    long nodes_ = 0;
+    bool timed_out_ = false;
+    std::chrono::steady_clock::time_point deadline_;
+
+    vector<pair<EntityId, Direction>> moves_;
+    int clusters_ = 0;
+    int engagements_ = 0;
+    int timeouts_ = 0;
+};
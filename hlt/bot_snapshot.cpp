@@ -0,0 +1,106 @@
+#include "bot_snapshot.hpp"
+
+#include <algorithm>
+
+template <typename Cell>
+static void append_bit_grid(vector<uint8_t>& out, int width, int height, Cell&& cell) {
+    size_t offset = out.size();
+    out.resize(offset + snapshot_grid_bytes(width, height), 0);
+    uint8_t* bits = &out[offset];
+    int i = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x, ++i) {
+            if (cell(x, y)) bits[i >> 3] |= static_cast<uint8_t>(1 << (i & 7));
+        }
+    }
+}
+
+bool SnapshotWriter::open(const string& path, const Game& game, size_t ships) {
+    if (!file_.open(path)) {
+        log::log("snapshot: cannot open " + path);
+        return false;
+    }
+    commands_.reserve(ships);
+
+    vector<uint8_t> record = file_.take_buffer();
+    record_begin(record, SNAPSHOT_GAME_MAGIC);
+    SnapshotGameHeader header;
+    header.version = SNAPSHOT_VERSION;
+    header.width = static_cast<uint16_t>(game.game_map->width);
+    header.height = static_cast<uint16_t>(game.game_map->height);
+    header.my_id = static_cast<uint16_t>(game.my_id);
+    header.num_players = static_cast<uint16_t>(game.players.size());
+    header.max_turns = static_cast<uint32_t>(constants::MAX_TURNS);
+    record_append(record, header);
+    record_close(record);
+    file_.submit(std::move(record));
+    return true;
+}
+
+void SnapshotWriter::write_turn(
+    const Game& game,
+    const ShipMemory& mem,
+    const CellGrid<float>& risk_map,
+    const vector<vector<bool>>& inspired,
+    const vector<vector<bool>>& claimed_targets,
+    const CellGrid<uint8_t>& next_turn_occupied,
+    const vector<pair<EntityId, Direction>>& moves,
+    const vector<EntityId>& constructs
+) {
+    if (!file_.is_open()) return;
+
+    int width = game.game_map->width;
+    int height = game.game_map->height;
+    const shared_ptr<Player>& me = game.me;
+
+    // Direction char of each move, 'c' for a dropoff
+    commands_.clear();
+    for (const auto& move : moves) commands_.emplace_back(move.first, static_cast<char>(move.second));
+    for (EntityId id : constructs) commands_.emplace_back(id, 'c');
+    std::sort(commands_.begin(), commands_.end());
+
+    vector<uint8_t> record = file_.take_buffer();
+    record_begin(record, SNAPSHOT_TURN_MAGIC);
+
+    SnapshotTurnHeader header;
+    header.turn = static_cast<uint32_t>(game.turn_number);
+    header.halite = static_cast<uint32_t>(me->halite);
+    header.ship_count = static_cast<uint16_t>(me->ships.size());
+    header.grid_count = SNAPSHOT_GRID_COUNT;
+    record_append(record, header);
+
+    append_bit_grid(record, width, height, [&](int x, int y) { return risk_map[y][x] > DANGER_RISK_THRESHOLD; });
+    append_bit_grid(record, width, height, [&](int x, int y) { return inspired[y][x]; });
+    append_bit_grid(record, width, height, [&](int x, int y) { return claimed_targets[y][x]; });
+    append_bit_grid(record, width, height, [&](int x, int y) { return next_turn_occupied[y][x]; });
+
+    for (const auto& ship_iterator : me->ships) {
+        const shared_ptr<Ship>& ship = ship_iterator.second;
+
+        SnapshotShip entry;
+        entry.id = static_cast<uint32_t>(ship->id);
+        entry.x = static_cast<uint16_t>(ship->position.x);
+        entry.y = static_cast<uint16_t>(ship->position.y);
+        entry.target_x = entry.x;
+        entry.target_y = entry.y;
+        entry.cargo = static_cast<uint16_t>(ship->halite);
+        entry.status = static_cast<uint8_t>(ShipState::MINING);
+        entry.command = 0;
+
+        auto target = mem.ship_target.find(ship->id);
+        if (target != mem.ship_target.end()) {
+            entry.target_x = static_cast<uint16_t>(target->second.x);
+            entry.target_y = static_cast<uint16_t>(target->second.y);
+        }
+        auto status = mem.ship_status.find(ship->id);
+        if (status != mem.ship_status.end()) entry.status = static_cast<uint8_t>(status->second);
+        auto command = std::lower_bound(commands_.begin(), commands_.end(), ship->id,
+            [](const pair<EntityId, char>& c, EntityId key) { return c.first < key; });
+        if (command != commands_.end() && command->first == ship->id) entry.command = command->second;
+
+        record_append(record, entry);
+    }
+
+    record_close(record);
+    file_.submit(std::move(record));
+}
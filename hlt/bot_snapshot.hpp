@@ -0,0 +1,99 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+#include "bot_record_file.hpp"
+#include "bot_ship_memory.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Snapshot archive: a record file (see bot_record_file.hpp). A GAME record opens every game appended to the archive
+// and is followed by one TURN record per turn. All fields are little endian and
+// 4-byte aligned so the file can be memory-mapped and read in place.
+//
+// TURN payload:
+//   SnapshotTurnHeader
+//   grid_count bit-packed grids (SnapshotGrid order), bit (y * width + x), each
+//   padded to a multiple of 4 bytes
+//   ship_count SnapshotShip
+static const uint32_t SNAPSHOT_GAME_MAGIC = 0x454d4147; // "GAME"
+static const uint32_t SNAPSHOT_TURN_MAGIC = 0x4e525554; // "TURN"
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+enum SnapshotGrid {
+    SNAPSHOT_DANGER,    // risk above DANGER_RISK_THRESHOLD
+    SNAPSHOT_INSPIRED,
+    SNAPSHOT_CLAIMED,   // claimed_targets
+    SNAPSHOT_OCCUPIED,  // next_turn_occupied once every command is decided
+    SNAPSHOT_GRID_COUNT
+};
+
+typedef RecordHeader SnapshotRecordHeader;
+
+struct SnapshotGameHeader {
+    uint32_t version;
+    uint16_t width;
+    uint16_t height;
+    uint16_t my_id;
+    uint16_t num_players;
+    uint32_t max_turns;
+};
+
+struct SnapshotTurnHeader {
+    uint32_t turn;
+    uint32_t halite;
+    uint16_t ship_count;
+    uint16_t grid_count;
+};
+
+struct SnapshotShip {
+    uint32_t id;
+    uint16_t x;
+    uint16_t y;
+    uint16_t target_x;
+    uint16_t target_y;
+    uint16_t cargo;
+    uint8_t status;  // ShipState
+    char command;    // Direction char, 'c' for a dropoff, 0 when no command was sent
+};
+
+static_assert(sizeof(SnapshotGameHeader) == 16, "snapshot layout");
+static_assert(sizeof(SnapshotTurnHeader) == 12, "snapshot layout");
+static_assert(sizeof(SnapshotShip) == 16, "snapshot layout");
+
+// Bytes of one bit-packed grid (padded to 4 bytes)
+inline size_t snapshot_grid_bytes(int width, int height) {
+    return ((static_cast<size_t>(width) * height + 31) / 32) * 4;
+}
+
+// Encodes snapshots on the game thread and appends them to the archive from a
+// background thread, so a turn only pays for bit-packing the grids.
+class SnapshotWriter {
+public:
+    // Append to path and write the GAME record. Returns false if the file can't be opened.
+    bool open(const string& path, const Game& game, size_t ships);
+
+    // moves: (ship, direction) of the turn's move commands; constructs: ships turned into dropoffs
+    void write_turn(
+        const Game& game,
+        const ShipMemory& mem,
+        const CellGrid<float>& risk_map,
+        const vector<vector<bool>>& inspired,
+        const vector<vector<bool>>& claimed_targets,
+        const CellGrid<uint8_t>& next_turn_occupied,
+        const vector<pair<EntityId, Direction>>& moves,
+        const vector<EntityId>& constructs
+    );
+
+private:
+    RecordFileWriter file_;
+    vector<pair<EntityId, char>> commands_;   // by ship id, sorted
+};
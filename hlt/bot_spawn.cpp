@@ -3,10 +3,11 @@
 void try_spawn(
     const shared_ptr<Player>& me,
     GameMap* game_map_ptr,
+    const EconomyTracker& economy,
     int turns_remaining,
-    vector<vector<bool>>& next_turn_occupied,
+    CellGrid<uint8_t>& next_turn_occupied,
     vector<Command>& command_queue,
-    int max_ships
+    FleetTelemetry* telemetry
 ) {
     // Improve spawn logic (stop earlier, avoid congestion)
     Position yard_pos = me->shipyard->position;
@@ -21,11 +22,12 @@ void try_spawn(
         }
     }
 
-    // Spawn based on conditions
+    // Spawn while one more ship pays for itself (remaining turns, map depletion and our income rate)
+    bool worth_it =
+        (economy.ship_return(turns_remaining) >= constants::SHIP_COST * SPAWN_MIN_RETURN) &&
+        (me->halite >= constants::SHIP_COST);
     bool can_spawn =
-        (turns_remaining > STOP_SPAWN_TURNS) &&
-        (me->ships.size() < static_cast<size_t>(max_ships)) &&
-        (me->halite >= constants::SHIP_COST + HALITE_RESERVE) &&
+        worth_it &&
         (nearby_ships < CONGESTION_LIMIT) &&
         (!next_turn_occupied[yard_pos.y][yard_pos.x]);
 
@@ -34,4 +36,8 @@ void try_spawn(
         // Marking shipyard position as occupied for the next turn to prevent collisions with newly spawned ship
         next_turn_occupied[yard_pos.y][yard_pos.x] = true;
     }
+    if (telemetry && worth_it) {
+        if (can_spawn) telemetry->count_spawn();
+        else telemetry->count_spawn_held();
+    }
 }
@@ -5,6 +5,8 @@
 #include "log.hpp"
 
 #include "bot_config.hpp"
+#include "bot_economy.hpp"
+#include "bot_telemetry.hpp"
 
 using namespace std;
 using namespace hlt;
@@ -12,8 +14,9 @@ using namespace hlt;
 void try_spawn(
     const shared_ptr<Player>& me,
     GameMap* game_map_ptr,
+    const EconomyTracker& economy,
     int turns_remaining,
-    vector<vector<bool>>& next_turn_occupied,
+    CellGrid<uint8_t>& next_turn_occupied,
     vector<Command>& command_queue,
-    int max_ships
+    FleetTelemetry* telemetry
 );
@@ -0,0 +1,160 @@
+#include "bot_speculation.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+TurnSpeculator::TurnSpeculator() {
+    worker_ = std::thread(&TurnSpeculator::run, this);
+}
+
+TurnSpeculator::~TurnSpeculator() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_one();
+    worker_.join();
+}
+
+void TurnSpeculator::reserve(size_t ships) {
+    predicted_ours_.reserve(ships + 1);
+    ours_.reserve(ships);
+    predicted_enemies_.reserve(ships * 4);
+    enemies_.reserve(ships * 4);
+}
+
+void TurnSpeculator::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        wake_.wait(lock, [this]() { return pending_ || stop_; });
+        if (stop_) return;
+        pending_ = false;
+        busy_ = true;
+        lock.unlock();
+
+        // The prediction and field_ belong to this thread until busy_ is cleared
+        field_.resize(*geometry_, my_id_);
+        field_.update_ours(predicted_ours_);
+        field_.update_enemies(predicted_enemies_);
+
+        lock.lock();
+        busy_ = false;
+        done_.notify_all();
+    }
+}
+
+void TurnSpeculator::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this]() { return !pending_ && !busy_; });
+}
+
+void TurnSpeculator::start(const Game& game, const vector<Command>& commands, const CellTopology& geometry) {
+    wait_idle();
+
+    geometry_ = &geometry;
+    width_ = geometry.width;
+    my_id_ = game.my_id;
+    const Player& me = *game.me;
+    const GameMap& game_map = *game.game_map;
+
+    // Our ships after the commands: "m <id> <dir>" moves (if the cargo pays for it), "c <id>" removes,
+    // "g" adds a ship on the yard; ships without a command stay
+    predicted_ours_.clear();
+    for (const auto& ship_pair : me.ships) {
+        predicted_ours_.push_back(static_cast<uint16_t>(ship_pair.second->position.y * width_ + ship_pair.second->position.x));
+    }
+    for (const Command& command : commands) {
+        const char* text = command.c_str();
+        if (text[0] == 'g') {
+            predicted_ours_.push_back(static_cast<uint16_t>(me.shipyard->position.y * width_ + me.shipyard->position.x));
+            continue;
+        }
+        if (text[0] != 'm' && text[0] != 'c') continue;
+
+        char* end = nullptr;
+        EntityId id = static_cast<EntityId>(std::strtol(text + 2, &end, 10));
+        auto it = me.ships.find(id);
+        if (it == me.ships.end()) continue;
+        const Ship& ship = *it->second;
+        uint16_t from = static_cast<uint16_t>(ship.position.y * width_ + ship.position.x);
+        auto slot = std::find(predicted_ours_.begin(), predicted_ours_.end(), from);
+        if (slot == predicted_ours_.end()) continue;
+
+        if (text[0] == 'c') {
+            *slot = predicted_ours_.back();
+            predicted_ours_.pop_back();
+            continue;
+        }
+        Direction direction = static_cast<Direction>(end[1]);
+        int halite_here = game_map.cells[ship.position.y][ship.position.x].halite;
+        if (direction == Direction::STILL || ship.halite < halite_here / constants::MOVE_COST_RATIO) continue;
+        *slot = geometry.neighbour(from, direction);
+    }
+    std::sort(predicted_ours_.begin(), predicted_ours_.end());
+
+    // Enemies hold still
+    predicted_enemies_.clear();
+    for (const auto& player_ptr : game.players) {
+        if (player_ptr->id == my_id_) continue;
+        for (const auto& ship_pair : player_ptr->ships) {
+            const Position& p = ship_pair.second->position;
+            predicted_enemies_.emplace_back(static_cast<uint16_t>(p.y * width_ + p.x), player_ptr->id);
+        }
+    }
+    std::sort(predicted_enemies_.begin(), predicted_enemies_.end());
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = true;
+        predicted_ = true;
+    }
+    wake_.notify_one();
+}
+
+void TurnSpeculator::collect(const Game& game) {
+    int width = game.game_map->width;
+    ours_.clear();
+    for (const auto& ship_pair : game.me->ships) {
+        const Position& p = ship_pair.second->position;
+        ours_.push_back(static_cast<uint16_t>(p.y * width + p.x));
+    }
+    std::sort(ours_.begin(), ours_.end());
+
+    enemies_.clear();
+    for (const auto& player_ptr : game.players) {
+        if (player_ptr->id == game.my_id) continue;
+        for (const auto& ship_pair : player_ptr->ships) {
+            const Position& p = ship_pair.second->position;
+            enemies_.emplace_back(static_cast<uint16_t>(p.y * width + p.x), player_ptr->id);
+        }
+    }
+    std::sort(enemies_.begin(), enemies_.end());
+}
+
+void TurnSpeculator::reconcile(const Game& game, const CellTopology& geometry, TerritoryField& territory) {
+    wait_idle();
+    territory.resize(geometry, game.my_id);
+    collect(game);
+
+    bool ours_match = predicted_ && ours_ == predicted_ours_;
+    bool enemies_match = predicted_ && enemies_ == predicted_enemies_;
+    predicted_ = false;
+
+    // Swapping hands the worker last turn's buffers, which it overwrites next time
+    if (ours_match) {
+        territory.adopt_ours(field_);
+        ++ours_reused_;
+    }
+    else {
+        territory.update_ours(ours_);
+    }
+    if (enemies_match) {
+        territory.adopt_enemies(field_);
+        ++enemies_reused_;
+    }
+    else {
+        territory.update_enemies(enemies_);
+    }
+    territory.count_cells();
+    ++reconciled_;
+}
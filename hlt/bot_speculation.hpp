@@ -0,0 +1,83 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+#include "bot_precompute.hpp"
+#include "bot_territory.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Precomputes the next turn while the engine and the other bots play this one.
+//
+// start() predicts the next frame from the commands just sent: our ships
+// where their moves take them (builders gone, a new ship on the yard after a
+// spawn) and every enemy ship where it is now. A worker thread computes the
+// territory distances of both sides on that prediction. When the real frame
+// arrives, reconcile() compares each side's ship cells with the prediction and
+// only recomputes the side that differs: ours usually matches (our moves are
+// our own), the enemies' when they all held still.
+class TurnSpeculator {
+public:
+    TurnSpeculator();
+    ~TurnSpeculator();
+
+    TurnSpeculator(const TurnSpeculator&) = delete;
+    TurnSpeculator& operator=(const TurnSpeculator&) = delete;
+
+    void reserve(size_t ships);
+
+    void start(const Game& game, const vector<Command>& commands, const CellTopology& geometry);
+
+    // Bring territory up to date with the real frame, from the prediction where it still holds
+    void reconcile(const Game& game, const CellTopology& geometry, TerritoryField& territory);
+
+    // Turns reconciled, and how often each side's prediction was used
+    int reconciled_turns() const { return reconciled_; }
+    int ours_reused() const { return ours_reused_; }
+    int enemies_reused() const { return enemies_reused_; }
+
+private:
+    void run();
+    void wait_idle();
+
+    // Ship cells of the real frame, sorted as the predictions are
+    void collect(const Game& game);
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    bool pending_ = false;
+    bool busy_ = false;
+    bool stop_ = false;
+    bool predicted_ = false;
+
+    int width_ = 0;
+    PlayerId my_id_ = 0;
+    const CellTopology* geometry_ = nullptr;
+
+    // Prediction (written by start() while the worker is idle, then read by the worker)
+    vector<uint16_t> predicted_ours_;
+    vector<pair<uint16_t, PlayerId>> predicted_enemies_;
+    TerritoryField field_;
+
+    // Real frame
+    vector<uint16_t> ours_;
+    vector<pair<uint16_t, PlayerId>> enemies_;
+
+    int reconciled_ = 0;
+    int ours_reused_ = 0;
+    int enemies_reused_ = 0;
+
+    // Started once every other member is constructed
+    std::thread worker_;
+};
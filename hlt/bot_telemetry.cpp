@@ -0,0 +1,250 @@
+#include "bot_telemetry.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+void FleetTelemetry::reserve(size_t ships) {
+    ships_.reserve(ships);
+    deposits_.reserve(MAX_DROPOFFS + 1);
+}
+
+FleetTelemetry::ShipRecord* FleetTelemetry::find(EntityId id) {
+    auto it = std::lower_bound(ships_.begin(), ships_.end(), id,
+        [](const ShipRecord& record, EntityId key) { return record.id < key; });
+    return it != ships_.end() && it->id == id ? &*it : nullptr;
+}
+
+FleetTelemetry::DepositRecord* FleetTelemetry::deposit_at(const Game& game, const Position& position) {
+    bool ours = game.me->shipyard->position == position;
+    for (const auto& dropoff_pair : game.me->dropoffs) ours = ours || dropoff_pair.second->position == position;
+    if (!ours) return nullptr;
+
+    for (DepositRecord& deposit : deposits_) {
+        if (deposit.position == position) return &deposit;
+    }
+    DepositRecord deposit;
+    deposit.position = position;
+    deposits_.push_back(deposit);
+    return &deposits_.back();
+}
+
+void FleetTelemetry::count_trip(ShipRecord& r, DepositRecord& deposit, int carried, int turn) {
+    r.deposited += carried;
+    ++r.trips;
+    r.trip_turns += turn - r.trip_start;
+    ++deposit.trips;
+    deposit.trip_turns += turn - r.trip_start;
+    deposit.deposited += carried;
+    if (r.returning_since >= 0) {
+        ++deposit.returns;
+        deposit.return_turns += turn - r.returning_since;
+    }
+    r.trip_start = turn;
+    r.returning_since = -1;
+}
+
+int FleetTelemetry::move_tax(const ShipRecord& r, const Position& to) {
+    if (to == r.position) return -1;
+    return r.cell_halite / (r.inspired ? constants::INSPIRED_MOVE_COST_RATIO : constants::MOVE_COST_RATIO);
+}
+
+void FleetTelemetry::observe(const Game& game, const ShipMemory& mem) {
+    const GameMap& game_map = *game.game_map;
+    int turn = game.turn_number;
+    ++turns_;
+
+    for (const auto& ship_pair : game.me->ships) {
+        const Ship& ship = *ship_pair.second;
+        int cell_halite = game_map.cells[ship.position.y][ship.position.x].halite;
+        ShipRecord* record = find(ship.id);
+        if (!record) {
+            ShipRecord born;
+            born.id = ship.id;
+            born.born_turn = turn;
+            born.last_turn = turn;
+            born.position = ship.position;
+            born.cargo = ship.halite;
+            born.cell_halite = cell_halite;
+            born.destination = ship.position;
+            born.trip_start = turn;
+            born.ship_turns = 1;
+            auto at = std::lower_bound(ships_.begin(), ships_.end(), ship.id,
+                [](const ShipRecord& r, EntityId key) { return r.id < key; });
+            ships_.insert(at, born);
+            continue;
+        }
+
+        ShipRecord& r = *record;
+        ++r.ship_turns;
+        // Status decided last turn, when the ship was at r.position
+        auto status = mem.ship_status.find(ship.id);
+        if (r.returning_since < 0 && status != mem.ship_status.end() && status->second == ShipState::RETURNING) {
+            r.returning_since = r.last_turn;
+        }
+
+        int tax = move_tax(r, ship.position);
+        if (tax >= 0) {
+            int carried = r.cargo - tax;
+            ++r.moves;
+            r.move_tax += tax;
+            DepositRecord* deposit = ship.halite == 0 && carried > 0 ? deposit_at(game, ship.position) : nullptr;
+            if (deposit) count_trip(r, *deposit, carried, turn);
+        }
+        else if (ship.halite > r.cargo) {
+            r.mined += ship.halite - r.cargo;
+        }
+        else if (!deposit_at(game, ship.position)) {
+            ++r.idle;
+        }
+
+        r.last_turn = turn;
+        r.position = ship.position;
+        r.cargo = ship.halite;
+        r.cell_halite = cell_halite;
+        r.destination = ship.position;
+        r.inspired = false;
+    }
+
+    // Ships that vanished: turned into one of our dropoffs, sunk in a collision on one of our
+    // deposits (the engine banks their cargo there), or sunk with their cargo anywhere else
+    for (ShipRecord& r : ships_) {
+        if (!r.alive || r.last_turn == turn) continue;
+        r.alive = false;
+        for (const auto& dropoff_pair : game.me->dropoffs) r.converted = r.converted || dropoff_pair.second->position == r.position;
+        if (r.converted) continue;
+
+        DepositRecord* deposit = deposit_at(game, r.destination);
+        if (!deposit) {
+            r.lost_cargo = r.cargo;
+            continue;
+        }
+        int tax = move_tax(r, r.destination);
+        int carried = r.cargo;
+        if (tax >= 0) {
+            carried -= tax;
+            ++r.moves;
+            r.move_tax += tax;
+        }
+        if (carried > 0) count_trip(r, *deposit, carried, turn);
+    }
+}
+
+void FleetTelemetry::record_moves(const Game& game, const vector<vector<bool>>& inspired, const vector<pair<EntityId, Direction>>& moves) {
+    const GameMap& game_map = *game.game_map;
+    for (const auto& move : moves) {
+        ShipRecord* r = find(move.first);
+        if (!r) continue;
+        r->destination = game_map.position(game_map.neighbour(game_map.cell_id(r->position), move.second));
+        r->inspired = inspired[r->position.y][r->position.x];
+    }
+}
+
+void FleetTelemetry::count_blocked(EntityId id) {
+    if (ShipRecord* r = find(id)) ++r->blocked;
+}
+
+void FleetTelemetry::count_stuck(EntityId id) {
+    if (ShipRecord* r = find(id)) ++r->stuck;
+}
+
+static string fixed(double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.3f", value);
+    return text;
+}
+
+static double share(long num, long den) {
+    return den > 0 ? static_cast<double>(num) / den : 0.0;
+}
+
+FleetTelemetry::ShipRecord FleetTelemetry::totals() const {
+    ShipRecord total = ShipRecord();
+    for (const ShipRecord& r : ships_) {
+        total.ship_turns += r.ship_turns;
+        total.mined += r.mined;
+        total.deposited += r.deposited;
+        total.moves += r.moves;
+        total.move_tax += r.move_tax;
+        total.idle += r.idle;
+        total.blocked += r.blocked;
+        total.stuck += r.stuck;
+        total.trips += r.trips;
+        total.trip_turns += r.trip_turns;
+        total.lost_cargo += r.lost_cargo;
+    }
+    return total;
+}
+
+string FleetTelemetry::summary_json(const Game& game) const {
+    ShipRecord total = totals();
+    int lost = 0;
+    int converted = 0;
+    for (const ShipRecord& r : ships_) {
+        lost += !r.alive && !r.converted;
+        converted += r.converted;
+    }
+
+    string json = "{\"player\":" + to_string(game.my_id)
+        + ",\"players\":" + to_string(game.players.size())
+        + ",\"width\":" + to_string(game.game_map->width)
+        + ",\"height\":" + to_string(game.game_map->height)
+        + ",\"turns\":" + to_string(turns_)
+        + ",\"bank\":" + to_string(game.me->halite)
+        + ",\"ships\":" + to_string(ships_.size())
+        + ",\"ship_turns\":" + to_string(total.ship_turns)
+        + ",\"mined\":" + to_string(total.mined)
+        + ",\"mined_per_ship_turn\":" + fixed(share(total.mined, total.ship_turns))
+        + ",\"deposited\":" + to_string(total.deposited)
+        + ",\"moves\":" + to_string(total.moves)
+        + ",\"move_tax\":" + to_string(total.move_tax)
+        + ",\"idle\":" + to_string(total.idle)
+        + ",\"blocked\":" + to_string(total.blocked)
+        + ",\"stuck\":" + to_string(total.stuck)
+        + ",\"ships_lost\":" + to_string(lost)
+        + ",\"cargo_lost\":" + to_string(total.lost_cargo)
+        + ",\"dropoffs_built\":" + to_string(converted)
+        + ",\"spawns\":" + to_string(spawns_)
+        + ",\"spawns_held\":" + to_string(spawns_held_)
+        + ",\"trips\":" + to_string(total.trips)
+        + ",\"mean_trip_turns\":" + fixed(share(total.trip_turns, total.trips));
+
+    json += ",\"deposits\":[";
+    for (size_t i = 0; i < deposits_.size(); ++i) {
+        const DepositRecord& d = deposits_[i];
+        json += string(i ? "," : "") + "{\"x\":" + to_string(d.position.x) + ",\"y\":" + to_string(d.position.y)
+            + ",\"trips\":" + to_string(d.trips)
+            + ",\"deposited\":" + to_string(d.deposited)
+            + ",\"mean_trip_turns\":" + fixed(share(d.trip_turns, d.trips))
+            + ",\"mean_return_turns\":" + fixed(share(d.return_turns, d.returns)) + "}";
+    }
+
+    json += "],\"per_ship\":[";
+    for (size_t i = 0; i < ships_.size(); ++i) {
+        const ShipRecord& r = ships_[i];
+        json += string(i ? "," : "") + "{\"id\":" + to_string(r.id)
+            + ",\"born\":" + to_string(r.born_turn)
+            + ",\"last\":" + to_string(r.last_turn)
+            + ",\"fate\":\"" + (r.alive ? "alive" : r.converted ? "dropoff" : "lost") + "\""
+            + ",\"turns\":" + to_string(r.ship_turns)
+            + ",\"mined\":" + to_string(r.mined)
+            + ",\"deposited\":" + to_string(r.deposited)
+            + ",\"moves\":" + to_string(r.moves)
+            + ",\"move_tax\":" + to_string(r.move_tax)
+            + ",\"idle\":" + to_string(r.idle)
+            + ",\"blocked\":" + to_string(r.blocked)
+            + ",\"stuck\":" + to_string(r.stuck)
+            + ",\"trips\":" + to_string(r.trips)
+            + ",\"cargo_lost\":" + to_string(r.lost_cargo) + "}";
+    }
+    json += "]}";
+    return json;
+}
+
+string FleetTelemetry::summary() const {
+    ShipRecord total = totals();
+    return "telemetry: " + to_string(ships_.size()) + " ships, mined/ship-turn " + fixed(share(total.mined, total.ship_turns))
+        + ", idle " + to_string(total.idle) + ", blocked " + to_string(total.blocked) + ", stuck " + to_string(total.stuck)
+        + ", move tax " + to_string(total.move_tax) + ", cargo lost " + to_string(total.lost_cargo)
+        + ", " + to_string(total.trips) + " trips of " + fixed(share(total.trip_turns, total.trips)) + " turns"
+        + ", spawns " + to_string(spawns_) + " (" + to_string(spawns_held_) + " held)";
+}
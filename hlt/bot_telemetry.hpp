@@ -0,0 +1,101 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+#include "bot_ship_memory.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// How well the fleet harvests, per ship and per game.
+//
+// observe() compares each frame with the last one: a ship that stayed put
+// mined its cargo gain (or idled when there was none), a ship that moved paid
+// floor(h / MOVE_COST_RATIO) of its previous cell (INSPIRED_MOVE_COST_RATIO
+// when inspired), a ship that emptied its cargo on one of our deposits
+// completed a trip, and a ship that vanished without becoming a dropoff was
+// lost with its cargo - unless it was sent onto one of our deposits, where the
+// engine banks the cargo of colliding ships. record_moves() keeps where each
+// ship was sent for that check. The decision code adds
+// what the frames can't tell: moves cancelled by a reservation (blocked), ships
+// that could not pay the move cost (stuck), and spawns. Lookups are a binary
+// search over the ships of the game; nothing allocates once reserved.
+class FleetTelemetry {
+public:
+    // ships: most ships of ours over a whole game (one spawn per turn at most)
+    void reserve(size_t ships);
+
+    // Diff the frame just read against the previous one
+    void observe(const Game& game, const ShipMemory& mem);
+    // The turn's final moves: where each ship was sent, and whether it paid the inspired move cost
+    void record_moves(const Game& game, const vector<vector<bool>>& inspired, const vector<pair<EntityId, Direction>>& moves);
+
+    // Decision-time counters
+    void count_blocked(EntityId id);
+    void count_stuck(EntityId id);
+    void count_spawn() { ++spawns_; }
+    void count_spawn_held() { ++spawns_held_; }
+
+    // One line per game: totals, per deposit, then per ship
+    string summary_json(const Game& game) const;
+    // "telemetry: mined/ship-turn .. idle .. ..." for the log
+    string summary() const;
+
+private:
+    struct ShipRecord {
+        EntityId id;
+        int born_turn;
+        int last_turn;             // Last turn the ship was seen
+        Position position;         // ... where, with that cargo, on a cell with that much halite
+        int cargo;
+        int cell_halite;
+        Position destination;      // Cell it was sent to that turn (its own cell when it held still)
+        bool inspired = false;     // Moved at the inspired cost that turn
+        int returning_since = -1;  // Turn the ship was first seen RETURNING on this leg, -1 otherwise
+        int trip_start;            // Turn of its last deposit (or spawn)
+        bool alive = true;
+        bool converted = false;    // Became a dropoff
+
+        int ship_turns = 0;
+        int mined = 0;
+        int deposited = 0;
+        int moves = 0;
+        int move_tax = 0;
+        int idle = 0;              // Stood still and mined nothing, away from our deposits
+        int blocked = 0;
+        int stuck = 0;
+        int trips = 0;
+        int trip_turns = 0;
+        int lost_cargo = 0;
+    };
+
+    struct DepositRecord {
+        Position position;
+        int trips = 0;
+        int trip_turns = 0;        // Deposit to deposit
+        int return_turns = 0;      // From turning RETURNING to the deposit
+        int returns = 0;
+        int deposited = 0;
+    };
+
+    ShipRecord* find(EntityId id);
+    // Counters summed over every ship of the game
+    ShipRecord totals() const;
+    DepositRecord* deposit_at(const Game& game, const Position& position);
+    // Cargo banked at a deposit ends the ship's trip
+    void count_trip(ShipRecord& r, DepositRecord& deposit, int carried, int turn);
+    // What moving off r.position cost, -1 if the ship held still
+    static int move_tax(const ShipRecord& r, const Position& to);
+
+    vector<ShipRecord> ships_;     // Sorted by id
+    vector<DepositRecord> deposits_;
+    int spawns_ = 0;
+    int spawns_held_ = 0;          // Affordable spawns held back by congestion or an occupied yard
+    int turns_ = 0;
+};
@@ -0,0 +1,141 @@
+#include "bot_territory.hpp"
+
+#include <algorithm>
+
+const uint16_t TerritoryField::UNREACHED;
+const PlayerId TerritoryField::CONTESTED;
+
+void TerritoryField::update(const Game& game, const CellTopology& geometry) {
+    resize(geometry, game.my_id);
+
+    our_seeds_.clear();
+    for (const auto& ship_pair : game.me->ships) {
+        our_seeds_.push_back(static_cast<uint16_t>(cell(ship_pair.second->position)));
+    }
+    update_ours(our_seeds_);
+
+    enemy_seeds_.clear();
+    for (const auto& player_ptr : game.players) {
+        if (player_ptr->id == my_id_) continue;
+        for (const auto& ship_pair : player_ptr->ships) {
+            enemy_seeds_.emplace_back(static_cast<uint16_t>(cell(ship_pair.second->position)), player_ptr->id);
+        }
+    }
+    update_enemies(enemy_seeds_);
+
+    count_cells();
+}
+
+void TerritoryField::resize(const CellTopology& geometry, PlayerId my_id) {
+    geometry_ = &geometry;
+    my_id_ = my_id;
+    if (width_ != geometry.width || height_ != geometry.height) {
+        width_ = geometry.width;
+        height_ = geometry.height;
+        int cells = width_ * height_;
+        our_dist_.assign(cells, UNREACHED);
+        enemy_dist_.assign(cells, UNREACHED);
+        enemy_owner_.assign(cells, CONTESTED);
+        frontier_.resize(cells);
+        our_seeds_.reserve(cells);
+        enemy_seeds_.reserve(cells);
+    }
+}
+
+void TerritoryField::update_ours(const vector<uint16_t>& ship_cells) {
+    std::fill(our_dist_.begin(), our_dist_.end(), UNREACHED);
+    int tail = 0;
+    for (uint16_t c : ship_cells) {
+        if (our_dist_[c] == 0) continue;
+        our_dist_[c] = 0;
+        frontier_[tail++] = c;
+    }
+    expand(our_dist_, nullptr, tail);
+}
+
+void TerritoryField::update_enemies(const vector<pair<uint16_t, PlayerId>>& ship_cells) {
+    std::fill(enemy_dist_.begin(), enemy_dist_.end(), UNREACHED);
+    std::fill(enemy_owner_.begin(), enemy_owner_.end(), CONTESTED);
+
+    // Every enemy fleet at once, each seed labelled with its player
+    int tail = 0;
+    for (const auto& seed : ship_cells) {
+        uint16_t c = seed.first;
+        if (enemy_dist_[c] == 0) {
+            if (enemy_owner_[c] != seed.second) enemy_owner_[c] = CONTESTED;
+            continue;
+        }
+        enemy_dist_[c] = 0;
+        enemy_owner_[c] = seed.second;
+        frontier_[tail++] = c;
+    }
+    expand(enemy_dist_, &enemy_owner_, tail);
+}
+
+void TerritoryField::count_cells() {
+    our_cells_ = 0;
+    for (size_t c = 0; c < our_dist_.size(); ++c) {
+        if (our_dist_[c] < enemy_dist_[c]) ++our_cells_;
+    }
+}
+
+void TerritoryField::expand(vector<uint16_t>& dist_vector, vector<PlayerId>* label_vector, int tail) {
+    // Raw pointers: the compiler cannot tell the frontier writes from the vectors' own pointers
+    const CellId* neighbours = geometry_->neighbours.data();
+    uint16_t* dist = dist_vector.data();
+    PlayerId* label = label_vector ? label_vector->data() : nullptr;
+    uint16_t* frontier = frontier_.data();
+    for (int head = 0; head < tail; ++head) {
+        int c = frontier[head];
+        uint16_t next = static_cast<uint16_t>(dist[c] + 1);
+        const CellId* around = neighbours + c * NEIGHBOUR_SLOTS;
+        for (int k = 0; k < NEIGHBOUR_STILL; ++k) {
+            int n = around[k];
+            if (dist[n] == UNREACHED) {
+                dist[n] = next;
+                if (label) label[n] = label[c];
+                frontier[tail++] = static_cast<uint16_t>(n);
+            }
+            else if (label && dist[n] == next && label[n] != label[c]) {
+                // Reached at the same distance from two players
+                label[n] = CONTESTED;
+            }
+        }
+    }
+}
+
+PlayerId TerritoryField::owner(const Position& pos) const {
+    int c = cell(pos);
+    if (our_dist_[c] < enemy_dist_[c]) return my_id_;
+    if (enemy_dist_[c] < our_dist_[c]) return enemy_owner_[c];
+    return CONTESTED;
+}
+
+double TerritoryField::share_in_square(const Position& center, int radius) const {
+    int ours = 0;
+    int total = 0;
+    for (int dy = -radius; dy <= radius; ++dy) {
+        int y = ((center.y + dy) % height_ + height_) % height_;
+        for (int dx = -radius; dx <= radius; ++dx) {
+            int x = ((center.x + dx) % width_ + width_) % width_;
+            int c = y * width_ + x;
+            if (our_dist_[c] < enemy_dist_[c]) ++ours;
+            ++total;
+        }
+    }
+    return static_cast<double>(ours) / total;
+}
+
+void penalize_enemy_territory(MiningGrids& grids, const TerritoryField& territory) {
+    PaddedGrid& shift = grids.claim_shift;
+    for (int y = 0; y < shift.height; ++y) {
+        int32_t* row = shift.row(y);
+        for (int x = 0; x < shift.width; ++x) {
+            Position pos(x, y);
+            if (row[x] < TERRITORY_SCORE_SHIFT && territory.enemy_distance(pos) < territory.our_distance(pos)) {
+                row[x] = TERRITORY_SCORE_SHIFT;
+            }
+        }
+    }
+    shift.refresh_padding();
+}
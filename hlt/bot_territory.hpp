@@ -0,0 +1,74 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+#include "bot_precompute.hpp"
+#include "bot_simd.hpp"
+
+#include <cstdint>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Who reaches each cell first.
+//
+// One breadth-first search seeded by all our ships gives our distance to every
+// cell, and one seeded by every enemy ship gives the nearest enemy distance and
+// which player it belongs to. Together they split the map into Voronoi regions:
+// a cell is ours when we are strictly closer, contested on a tie. Both searches
+// are linear in cells and run on the same frontier buffer, kept across turns.
+class TerritoryField {
+public:
+    static const uint16_t UNREACHED = 0xffff;
+    static const PlayerId CONTESTED = -1;
+
+    void update(const Game& game, const CellTopology& geometry);
+
+    // The two halves of update(), seeded by cells (sorted or not, duplicates allowed)
+    void resize(const CellTopology& geometry, PlayerId my_id);
+    void update_ours(const vector<uint16_t>& ship_cells);
+    void update_enemies(const vector<pair<uint16_t, PlayerId>>& ship_cells);
+    // Take the distances of one side from other (same map), leaving it ours in exchange
+    void adopt_ours(TerritoryField& other) { our_dist_.swap(other.our_dist_); }
+    void adopt_enemies(TerritoryField& other) { enemy_dist_.swap(other.enemy_dist_); enemy_owner_.swap(other.enemy_owner_); }
+    // After the halves are set
+    void count_cells();
+
+    int our_distance(const Position& pos) const { return our_dist_[cell(pos)]; }
+    int enemy_distance(const Position& pos) const { return enemy_dist_[cell(pos)]; }
+
+    // Nearest player (CONTESTED on a tie)
+    PlayerId owner(const Position& pos) const;
+    bool is_ours(const Position& pos) const { return our_dist_[cell(pos)] < enemy_dist_[cell(pos)]; }
+
+    // Fraction of the square of the given radius around center that is ours
+    double share_in_square(const Position& center, int radius) const;
+
+    int our_cell_count() const { return our_cells_; }
+
+private:
+    int cell(const Position& pos) const { return pos.y * width_ + pos.x; }
+
+    // Breadth-first expansion of the seeds already in frontier_[0 .. tail), labels spread along when given
+    void expand(vector<uint16_t>& dist, vector<PlayerId>* label, int tail);
+
+    int width_ = 0;
+    int height_ = 0;
+    PlayerId my_id_ = 0;
+    const CellTopology* geometry_ = nullptr;
+
+    vector<uint16_t> our_dist_;
+    vector<uint16_t> enemy_dist_;
+    vector<PlayerId> enemy_owner_;
+    vector<uint16_t> frontier_;
+    vector<uint16_t> our_seeds_;
+    vector<pair<uint16_t, PlayerId>> enemy_seeds_;
+    int our_cells_ = 0;
+};
+
+// SIMD scan: cells an enemy reaches first score >> TERRITORY_SCORE_SHIFT (unless already claimed)
+void penalize_enemy_territory(MiningGrids& grids, const TerritoryField& territory);
@@ -0,0 +1,201 @@
+#include "bot_verifier.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+const char* mismatch_cause_name(MismatchCause cause) {
+    switch (cause) {
+        case MismatchCause::SELF_COLLISION: return "self_collision";
+        case MismatchCause::LOST: return "lost";
+        case MismatchCause::POSITION: return "position";
+        case MismatchCause::CARGO: return "cargo";
+        case MismatchCause::INSPIRATION: return "inspiration";
+        case MismatchCause::SPAWN: return "spawn";
+        case MismatchCause::DROPOFF: return "dropoff";
+        case MismatchCause::BANK: return "bank";
+        default: return "unknown";
+    }
+}
+
+// Cargo after mining a cell holding halite_here for one turn (the engine's extraction rules)
+static int mine(int cargo, int halite_here, bool inspired) {
+    int ratio = inspired ? constants::INSPIRED_EXTRACT_RATIO : constants::EXTRACT_RATIO;
+    int mined = std::min((halite_here + ratio - 1) / ratio, constants::MAX_HALITE - cargo);
+    cargo += mined;
+    if (inspired) {
+        int bonus = static_cast<int>(mined * constants::INSPIRED_BONUS_MULTIPLIER);
+        cargo += std::min(bonus, constants::MAX_HALITE - cargo);
+    }
+    return cargo;
+}
+
+void TurnVerifier::reserve(size_t ships, int cells) {
+    ships_.reserve(ships);
+    deposits_.reserve(ships + 1);
+    arrivals_.assign(cells, 0);
+}
+
+TurnVerifier::PredictedShip* TurnVerifier::find(EntityId id) {
+    PredictedShip key;
+    key.id = id;
+    auto it = std::lower_bound(ships_.begin(), ships_.end(), key);
+    return (it != ships_.end() && it->id == id) ? &*it : nullptr;
+}
+
+void TurnVerifier::predict(const Game& game, Halite bank, const vector<vector<bool>>& inspired, const vector<Command>& commands) {
+    const Player& me = *game.me;
+    const GameMap& game_map = *game.game_map;
+    size_t cells = static_cast<size_t>(game_map.width) * game_map.height;
+    if (arrivals_.size() != cells) arrivals_.assign(cells, 0);
+
+    ships_.clear();
+    for (const auto& ship_pair : me.ships) {
+        const Ship& ship = *ship_pair.second;
+        PredictedShip p;
+        p.id = ship.id;
+        p.cell = game_map.cell_id(ship.position);
+        p.halite = ship.halite;
+        p.other_halite = ship.halite;
+        p.converted = false;
+        p.on_deposit = false;
+        p.sinks = false;
+        ships_.push_back(p);
+    }
+    std::sort(ships_.begin(), ships_.end());
+
+    deposits_.clear();
+    deposits_.push_back(game_map.cell_id(me.shipyard->position));
+    for (const auto& dropoff_pair : me.dropoffs) {
+        deposits_.push_back(game_map.cell_id(dropoff_pair.second->position));
+    }
+    dropoffs_ = me.dropoffs.size();
+    spawned_ = 0;
+    bank_ = bank;
+
+    // Moving ships change cell here; ships without a command (or "o") mine below
+    for (const Command& command : commands) {
+        const char* text = command.c_str();
+        if (text[0] == 'g') {
+            bank_ -= constants::SHIP_COST;
+            ++spawned_;
+            continue;
+        }
+        if (text[0] != 'm' && text[0] != 'c') continue;
+
+        char* end = nullptr;
+        EntityId id = static_cast<EntityId>(std::strtol(text + 2, &end, 10));
+        PredictedShip* p = find(id);
+        if (!p) continue;
+        Position pos = game_map.position(p->cell);
+        int halite_here = game_map.cells.at(p->cell).halite;
+
+        if (text[0] == 'c') {
+            bank_ += p->halite + halite_here - constants::DROPOFF_COST;
+            p->converted = true;
+            ++dropoffs_;
+            continue;
+        }
+        Direction direction = static_cast<Direction>(end[1]);
+        if (direction == Direction::STILL) continue;
+
+        // Move cost is rounded down by the engine, and uses the inspired ratio on inspired cells
+        bool is_inspired = constants::INSPIRATION_ENABLED && inspired[pos.y][pos.x];
+        int cost = halite_here / (is_inspired ? constants::INSPIRED_MOVE_COST_RATIO : constants::MOVE_COST_RATIO);
+        int other_cost = halite_here / (is_inspired ? constants::MOVE_COST_RATIO : constants::INSPIRED_MOVE_COST_RATIO);
+        if (p->halite < cost) continue;
+
+        int cargo = p->halite;
+        p->cell = game_map.neighbour(p->cell, direction);
+        p->halite = cargo - cost;
+        p->other_halite = cargo >= other_cost ? cargo - other_cost : cargo;
+    }
+
+    // Ships still on their cell mine; every ship on a deposit unloads
+    for (const auto& ship_pair : me.ships) {
+        const Ship& ship = *ship_pair.second;
+        PredictedShip* p = find(ship.id);
+        if (!p || p->converted) continue;
+        const Position& pos = ship.position;
+        if (p->cell == game_map.cell_id(pos)) {
+            bool is_inspired = constants::INSPIRATION_ENABLED && inspired[pos.y][pos.x];
+            int halite_here = game_map.cells.at(p->cell).halite;
+            p->halite = mine(ship.halite, halite_here, is_inspired);
+            p->other_halite = mine(ship.halite, halite_here, !is_inspired);
+        }
+        if (std::find(deposits_.begin(), deposits_.end(), p->cell) != deposits_.end()) {
+            bank_ += p->halite;
+            p->on_deposit = true;
+            p->halite = 0;
+            p->other_halite = 0;
+        }
+        if (arrivals_[p->cell] < 255) ++arrivals_[p->cell];
+    }
+
+    // A spawned ship appears on the yard, where it sinks along with any ship of ours that stayed there
+    if (spawned_ > 0 && arrivals_[deposits_[0]] < 255) ++arrivals_[deposits_[0]];
+    if (spawned_ > 0 && arrivals_[deposits_[0]] > 1) spawned_ = 0;
+
+    for (PredictedShip& p : ships_) {
+        if (p.converted) continue;
+        if (arrivals_[p.cell] > 1) p.sinks = true;
+    }
+    for (const PredictedShip& p : ships_) arrivals_[p.cell] = 0;
+    arrivals_[deposits_[0]] = 0;
+
+    predicted_ = true;
+}
+
+void TurnVerifier::mismatch(MismatchCause cause) {
+    ++counts_[static_cast<int>(cause)];
+    ++last_mismatches_;
+}
+
+void TurnVerifier::verify(const Game& game) {
+    last_mismatches_ = 0;
+    if (!predicted_) return;
+    predicted_ = false;
+
+    const Player& me = *game.me;
+    const GameMap& game_map = *game.game_map;
+
+    for (const PredictedShip& p : ships_) {
+        auto it = me.ships.find(p.id);
+        if (p.converted) {
+            if (it != me.ships.end()) mismatch(MismatchCause::DROPOFF);
+            continue;
+        }
+        if (it == me.ships.end()) {
+            // Piling into one of our deposits loses nothing: the cargo is banked either way
+            if (!p.sinks) mismatch(MismatchCause::LOST);
+            else if (!p.on_deposit) mismatch(MismatchCause::SELF_COLLISION);
+            continue;
+        }
+        const Ship& ship = *it->second;
+        if (p.sinks || game_map.cell_id(ship.position) != p.cell) {
+            mismatch(MismatchCause::POSITION);
+        }
+        else if (ship.halite != p.halite) {
+            mismatch(ship.halite == p.other_halite ? MismatchCause::INSPIRATION : MismatchCause::CARGO);
+        }
+    }
+
+    // Ship ids only grow, so new ships are the ones missing from the prediction
+    int spawned = 0;
+    for (const auto& ship_pair : me.ships) {
+        if (!find(ship_pair.first)) ++spawned;
+    }
+    if (spawned != spawned_) mismatch(MismatchCause::SPAWN);
+    if (me.dropoffs.size() != dropoffs_) mismatch(MismatchCause::DROPOFF);
+    if (me.halite != bank_) mismatch(MismatchCause::BANK);
+
+    ++verified_turns_;
+    if (last_mismatches_ > 0) ++mismatched_turns_;
+}
+
+string TurnVerifier::summary() const {
+    string text = "verifier: " + to_string(verified_turns_) + " turns, " + to_string(mismatched_turns_) + " mismatched";
+    for (int c = 0; c < static_cast<int>(MismatchCause::COUNT); ++c) {
+        text += string(c == 0 ? ", " : " ") + mismatch_cause_name(static_cast<MismatchCause>(c)) + "=" + to_string(counts_[c]);
+    }
+    return text;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "game.hpp"
+#include "constants.hpp"
+#include "log.hpp"
+
+#include "bot_config.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+// Why the next frame disagreed with the prediction for one of our ships (or for the player)
+enum class MismatchCause {
+    SELF_COLLISION, // two of our ships sunk each other away from our deposits (reservations out of sync)
+    LOST,           // ship gone without us predicting it (enemy collision)
+    POSITION,       // ship alive but elsewhere (a move that did not happen, or one we did not expect)
+    CARGO,          // right cell, wrong cargo (mining or move cost rounding)
+    INSPIRATION,    // cargo matches the other inspiration status
+    SPAWN,          // new ships differ from the "g" we sent
+    DROPOFF,        // dropoffs differ from the "c" we sent
+    BANK,           // player halite differs
+    COUNT
+};
+
+const char* mismatch_cause_name(MismatchCause cause);
+
+// Checks our commands against what the engine did with them.
+//
+// predict() applies the command queue to a model of our side of the frame:
+// moves paid at the engine's floor(h / MOVE_COST_RATIO), mining with the
+// inspiration grid the bot used, deposits, dropoff construction at
+// DROPOFF_COST minus the cargo and cell halite, and spawns. verify() compares
+// the next frame with it ship by ship and counts each mismatch by cause. Enemy
+// ships are not modelled, so collisions with them show up as LOST.
+// Both passes are linear in our fleet and do not allocate once reserved.
+class TurnVerifier {
+public:
+    void reserve(size_t ships, int cells);
+
+    // bank: player halite at the start of the turn (before the bot's own deductions)
+    void predict(const Game& game, Halite bank, const vector<vector<bool>>& inspired, const vector<Command>& commands);
+
+    // Compare the frame just read with the last prediction (no-op on the first turn)
+    void verify(const Game& game);
+
+    int count(MismatchCause cause) const { return counts_[static_cast<int>(cause)]; }
+    int verified_turns() const { return verified_turns_; }
+    int mismatched_turns() const { return mismatched_turns_; }
+    // Mismatches found by the last verify()
+    int last_mismatches() const { return last_mismatches_; }
+
+    // "verifier: <turns> turns, <mismatched> mismatched, self_collision=.. lost=.. ..."
+    string summary() const;
+
+private:
+    struct PredictedShip {
+        EntityId id;
+        CellId cell;
+        int halite;
+        int other_halite;  // cargo had the inspiration status been the other one
+        bool converted;
+        bool on_deposit;
+        bool sinks;        // another of our ships (or the spawn) ends on the same cell
+
+        bool operator<(const PredictedShip& other) const { return id < other.id; }
+    };
+
+    PredictedShip* find(EntityId id);
+    void mismatch(MismatchCause cause);
+
+    bool predicted_ = false;
+    vector<PredictedShip> ships_;
+    vector<CellId> deposits_;
+    vector<uint8_t> arrivals_;  // per CellId, cleared after each predict()
+    Halite bank_ = 0;
+    size_t dropoffs_ = 0;
+    int spawned_ = 0;
+
+    int counts_[static_cast<int>(MismatchCause::COUNT)] = {};
+    int verified_turns_ = 0;
+    int mismatched_turns_ = 0;
+    int last_mismatches_ = 0;
+};
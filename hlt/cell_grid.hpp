@@ -0,0 +1,126 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// Storage of one value per map cell, with the memory layout chosen at build time
+// (see GridLayout). Accessors are the same for every layout: grid(x, y),
+// grid.at(cell) by CellId, and grid[y][x] through a row handle, so code written
+// against vector<vector<T>> rows keeps compiling. Only the order of the slots in
+// memory changes.
+
+namespace hlt {
+    // Cell (x, y) at y * width + x
+    struct RowMajorLayout {
+        static const char* name() { return "row-major"; }
+
+        int width = 0;
+
+        void resize(int w, int h) { (void)h; width = w; }
+        std::size_t slots(int w, int h) const { return static_cast<std::size_t>(w) * h; }
+
+        // A CellId is already the row-major index
+        std::size_t cell_offset(CellId cell) const { return cell; }
+
+        // index(x, y) == row_offset(y) + column_offset(x)
+        std::size_t row_offset(int y) const { return static_cast<std::size_t>(y) * width; }
+        std::size_t column_offset(int x) const { return static_cast<std::size_t>(x); }
+    };
+
+    // 8x8 tiles one after the other, row of tiles by row of tiles, and the 64 cells of a
+    // tile in Morton (Z) order: every aligned 2x2, 4x4 and 8x8 block is contiguous, so a
+    // window scan touches a few tiles instead of one cache line stream per row.
+    // Maps whose sides are not multiples of 8 get padding slots, left default constructed.
+    struct TiledLayout {
+        static const int TILE_SHIFT = 3;
+        static const int TILE_SIZE = 1 << TILE_SHIFT;
+        static const int TILE_SLOTS = TILE_SIZE * TILE_SIZE;
+
+        static const char* name() { return "tiled"; }
+
+        int width = 0;
+        int tiles_width = 0;
+
+        void resize(int w, int h) { (void)h; width = w; tiles_width = (w + TILE_SIZE - 1) / TILE_SIZE; }
+        std::size_t slots(int w, int h) const {
+            return static_cast<std::size_t>((w + TILE_SIZE - 1) / TILE_SIZE) * ((h + TILE_SIZE - 1) / TILE_SIZE) * TILE_SLOTS;
+        }
+
+        // Bits b2 b1 b0 to b2 0 b1 0 b0: x takes the even bits of the Morton code, y the odd ones
+        static std::size_t spread(int v) { return static_cast<std::size_t>((v & 1) | ((v & 2) << 1) | ((v & 4) << 2)); }
+
+        std::size_t row_offset(int y) const {
+            return static_cast<std::size_t>(y >> TILE_SHIFT) * tiles_width * TILE_SLOTS + (spread(y & (TILE_SIZE - 1)) << 1);
+        }
+        std::size_t column_offset(int x) const {
+            return static_cast<std::size_t>(x >> TILE_SHIFT) * TILE_SLOTS + spread(x & (TILE_SIZE - 1));
+        }
+        std::size_t cell_offset(CellId cell) const { return row_offset(cell / width) + column_offset(cell % width); }
+    };
+
+#ifdef HLT_TILED_GRIDS
+    typedef TiledLayout GridLayout;
+#else
+    typedef RowMajorLayout GridLayout;
+#endif
+
+    template <typename T, typename Layout = GridLayout>
+    class CellGrid {
+    public:
+        // Handle on row y: row[x] is cell (x, y)
+        template <typename Cell>
+        class RowRef {
+        public:
+            RowRef(Cell* row, const Layout* layout) : row_(row), layout_(layout) {}
+            Cell& operator[](int x) const { return row_[layout_->column_offset(x)]; }
+
+        private:
+            Cell* row_;
+            const Layout* layout_;
+        };
+
+        typedef RowRef<T> Row;
+        typedef RowRef<const T> ConstRow;
+
+        // Every slot default constructed
+        void resize(int width, int height) {
+            width_ = width;
+            height_ = height;
+            layout_.resize(width, height);
+            slots_.assign(layout_.slots(width, height), T());
+        }
+
+        int width() const { return width_; }
+        int height() const { return height_; }
+        const Layout& layout() const { return layout_; }
+
+        std::size_t index(int x, int y) const { return layout_.row_offset(y) + layout_.column_offset(x); }
+
+        T& operator()(int x, int y) { return slots_[index(x, y)]; }
+        const T& operator()(int x, int y) const { return slots_[index(x, y)]; }
+
+        T& at(CellId cell) { return slots_[layout_.cell_offset(cell)]; }
+        const T& at(CellId cell) const { return slots_[layout_.cell_offset(cell)]; }
+
+        // Every slot set to value (the grid keeps its size)
+        void fill(const T& value) { std::fill(slots_.begin(), slots_.end(), value); }
+
+        Row operator[](int y) { return Row(slots_.data() + layout_.row_offset(y), &layout_); }
+        ConstRow operator[](int y) const { return ConstRow(slots_.data() + layout_.row_offset(y), &layout_); }
+
+        // Every slot in memory order, for whole-grid passes (padding slots are default constructed)
+        typename std::vector<T>::iterator begin() { return slots_.begin(); }
+        typename std::vector<T>::iterator end() { return slots_.end(); }
+        typename std::vector<T>::const_iterator begin() const { return slots_.begin(); }
+        typename std::vector<T>::const_iterator end() const { return slots_.end(); }
+
+    private:
+        int width_ = 0;
+        int height_ = 0;
+        Layout layout_;
+        std::vector<T> slots_;
+    };
+}
@@ -0,0 +1,51 @@
+#include "cell_id.hpp"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+static std::shared_ptr<const hlt::CellTopology> build_cell_topology(int w, int h) {
+    std::shared_ptr<hlt::CellTopology> topology = std::make_shared<hlt::CellTopology>();
+    topology->width = w;
+    topology->height = h;
+
+    topology->neighbours.resize(static_cast<size_t>(w) * h * hlt::NEIGHBOUR_SLOTS);
+    topology->cell_x.resize(static_cast<size_t>(w) * h);
+    topology->cell_y.resize(static_cast<size_t>(w) * h);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            int cell = y * w + x;
+            topology->cell_x[cell] = static_cast<uint8_t>(x);
+            topology->cell_y[cell] = static_cast<uint8_t>(y);
+            hlt::Position here(x, y);
+            for (int k = 0; k < 4; ++k) {
+                hlt::Position p = here.directional_offset(hlt::ALL_CARDINALS[k]);
+                p.x = (p.x + w) % w;
+                p.y = (p.y + h) % h;
+                topology->neighbours[cell * hlt::NEIGHBOUR_SLOTS + k] = static_cast<hlt::CellId>(p.y * w + p.x);
+            }
+            topology->neighbours[cell * hlt::NEIGHBOUR_SLOTS + hlt::NEIGHBOUR_STILL] = static_cast<hlt::CellId>(cell);
+        }
+    }
+
+    topology->delta_stride = 2 * w - 1;
+    topology->delta_distance.resize(static_cast<size_t>(2 * h - 1) * topology->delta_stride);
+    for (int dy = -(h - 1); dy < h; ++dy) {
+        for (int dx = -(w - 1); dx < w; ++dx) {
+            int distance = std::min(std::abs(dx), w - std::abs(dx)) + std::min(std::abs(dy), h - std::abs(dy));
+            topology->delta_distance[(dy + h - 1) * topology->delta_stride + dx + w - 1] = static_cast<uint8_t>(distance);
+        }
+    }
+
+    return topology;
+}
+
+std::shared_ptr<const hlt::CellTopology> hlt::shared_cell_topology(int width, int height) {
+    static std::mutex cache_mutex;
+    static std::map<std::pair<int, int>, std::shared_ptr<const CellTopology>> cache;
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    std::shared_ptr<const CellTopology>& entry = cache[std::make_pair(width, height)];
+    if (!entry) entry = build_cell_topology(width, height);
+    return entry;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "types.hpp"
+#include "position.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// Cells as a dense CellId (y * width + x) and the per-map tables that make
+// stepping and distances on them single lookups instead of a switch on the
+// direction plus wrap-around modulos.
+
+namespace hlt {
+    // Slot of STILL in the neighbour table (the first 4 follow ALL_CARDINALS)
+    static const int NEIGHBOUR_STILL = 4;
+    static const int NEIGHBOUR_SLOTS = 5;
+
+    // Slot of a direction in the neighbour table, from its command letter
+    inline int neighbour_slot(Direction direction) {
+        // 'n' 's' 'e' 'w' 'o' & 31 = 14 19 5 23 15
+        static const int8_t slots[32] = {
+            4, 4, 4, 4, 4, 2, 4, 4, 4, 4, 4, 4, 4, 4, 0, 4,
+            4, 4, 4, 1, 4, 4, 4, 3, 4, 4, 4, 4, 4, 4, 4, 4
+        };
+        return slots[static_cast<unsigned char>(direction) & 31];
+    }
+
+    inline Direction slot_direction(int slot) {
+        return slot == NEIGHBOUR_STILL ? Direction::STILL : ALL_CARDINALS[slot];
+    }
+
+    // Tables that only depend on the map size, shared by every game of that size
+    struct CellTopology {
+        int width = 0;
+        int height = 0;
+
+        // neighbours[cell * NEIGHBOUR_SLOTS + k] = cell reached by ALL_CARDINALS[k] (k = NEIGHBOUR_STILL: the cell)
+        std::vector<CellId> neighbours;
+        // Coordinates of each cell
+        std::vector<uint8_t> cell_x;
+        std::vector<uint8_t> cell_y;
+        // Toroidal distance by raw offset: delta_distance[(dy + height - 1) * delta_stride + dx + width - 1]
+        std::vector<uint8_t> delta_distance;
+        int delta_stride = 0;
+
+        int cell_count() const { return width * height; }
+
+        // p must be normalized
+        CellId id(const Position& p) const { return static_cast<CellId>(p.y * width + p.x); }
+        Position position(CellId cell) const { return Position(cell_x[cell], cell_y[cell]); }
+
+        CellId neighbour(CellId cell, int slot) const { return neighbours[cell * NEIGHBOUR_SLOTS + slot]; }
+        CellId neighbour(CellId cell, Direction direction) const { return neighbour(cell, neighbour_slot(direction)); }
+
+        int distance(CellId a, CellId b) const {
+            return delta_distance[(cell_y[b] - cell_y[a] + height - 1) * delta_stride + cell_x[b] - cell_x[a] + width - 1];
+        }
+        // Same for normalized positions
+        int distance(const Position& a, const Position& b) const {
+            return delta_distance[(b.y - a.y + height - 1) * delta_stride + b.x - a.x + width - 1];
+        }
+    };
+
+    // Built on first use for each map size (thread safe)
+    std::shared_ptr<const CellTopology> shared_cell_topology(int width, int height);
+}
@@ -9,21 +9,53 @@ using namespace hlt;
 
 namespace hlt {
     namespace constants {
-        int MAX_HALITE;
-        int SHIP_COST;
-        int DROPOFF_COST;
-        int MAX_TURNS;
-        int EXTRACT_RATIO;
-        int MOVE_COST_RATIO;
-        bool INSPIRATION_ENABLED;
-        int INSPIRATION_RADIUS;
-        int INSPIRATION_SHIP_COUNT;
-        int INSPIRED_EXTRACT_RATIO;
-        double INSPIRED_BONUS_MULTIPLIER;
-        int INSPIRED_MOVE_COST_RATIO;
+        thread_local int MAX_HALITE;
+        thread_local int SHIP_COST;
+        thread_local int DROPOFF_COST;
+        thread_local int MAX_TURNS;
+        thread_local int EXTRACT_RATIO;
+        thread_local int MOVE_COST_RATIO;
+        thread_local bool INSPIRATION_ENABLED;
+        thread_local int INSPIRATION_RADIUS;
+        thread_local int INSPIRATION_SHIP_COUNT;
+        thread_local int INSPIRED_EXTRACT_RATIO;
+        thread_local double INSPIRED_BONUS_MULTIPLIER;
+        thread_local int INSPIRED_MOVE_COST_RATIO;
     }
 }
 
+hlt::constants::Snapshot hlt::constants::save() {
+    Snapshot snapshot;
+    snapshot.max_halite = MAX_HALITE;
+    snapshot.ship_cost = SHIP_COST;
+    snapshot.dropoff_cost = DROPOFF_COST;
+    snapshot.max_turns = MAX_TURNS;
+    snapshot.extract_ratio = EXTRACT_RATIO;
+    snapshot.move_cost_ratio = MOVE_COST_RATIO;
+    snapshot.inspiration_enabled = INSPIRATION_ENABLED;
+    snapshot.inspiration_radius = INSPIRATION_RADIUS;
+    snapshot.inspiration_ship_count = INSPIRATION_SHIP_COUNT;
+    snapshot.inspired_extract_ratio = INSPIRED_EXTRACT_RATIO;
+    snapshot.inspired_bonus_multiplier = INSPIRED_BONUS_MULTIPLIER;
+    snapshot.inspired_move_cost_ratio = INSPIRED_MOVE_COST_RATIO;
+    return snapshot;
+}
+
+void hlt::constants::restore(const Snapshot& snapshot) {
+    MAX_HALITE = snapshot.max_halite;
+    SHIP_COST = snapshot.ship_cost;
+    DROPOFF_COST = snapshot.dropoff_cost;
+    MAX_TURNS = snapshot.max_turns;
+    EXTRACT_RATIO = snapshot.extract_ratio;
+    MOVE_COST_RATIO = snapshot.move_cost_ratio;
+    INSPIRATION_ENABLED = snapshot.inspiration_enabled;
+    INSPIRATION_RADIUS = snapshot.inspiration_radius;
+    INSPIRATION_SHIP_COUNT = snapshot.inspiration_ship_count;
+    INSPIRED_EXTRACT_RATIO = snapshot.inspired_extract_ratio;
+    INSPIRED_BONUS_MULTIPLIER = snapshot.inspired_bonus_multiplier;
+    INSPIRED_MOVE_COST_RATIO = snapshot.inspired_move_cost_ratio;
+}
+
 static std::string get_string(std::unordered_map<std::string, std::string>& map, const std::string& key) {
     auto it = map.find(key);
     if (it == map.end()) {
@@ -7,33 +7,54 @@ namespace hlt {
      * The constants representing the game variation being played.
      * They come from game engine and changing them has no effect.
      * They are strictly informational.
+     *
+     * They are per thread so that several games can be played by one process.
      */
     namespace constants {
         void populate_constants(const std::string& string_from_engine);
 
+        /** Every constant of one game, to switch between games sharing a thread. */
+        struct Snapshot {
+            int max_halite;
+            int ship_cost;
+            int dropoff_cost;
+            int max_turns;
+            int extract_ratio;
+            int move_cost_ratio;
+            bool inspiration_enabled;
+            int inspiration_radius;
+            int inspiration_ship_count;
+            int inspired_extract_ratio;
+            double inspired_bonus_multiplier;
+            int inspired_move_cost_ratio;
+        };
+
+        Snapshot save();
+        void restore(const Snapshot& snapshot);
+
         /** The maximum amount of halite a ship can carry. */
-        extern int MAX_HALITE;
+        extern thread_local int MAX_HALITE;
         /** The cost to build a single ship. */
-        extern int SHIP_COST;
+        extern thread_local int SHIP_COST;
         /** The cost to build a dropoff. */
-        extern int DROPOFF_COST;
+        extern thread_local int DROPOFF_COST;
         /** The maximum number of turns a game can last. */
-        extern int MAX_TURNS;
+        extern thread_local int MAX_TURNS;
         /** 1/EXTRACT_RATIO halite (rounded) is collected from a square per turn. */
-        extern int EXTRACT_RATIO;
+        extern thread_local int EXTRACT_RATIO;
         /** 1/MOVE_COST_RATIO halite (rounded) is needed to move off a cell. */
-        extern int MOVE_COST_RATIO;
+        extern thread_local int MOVE_COST_RATIO;
         /** Whether inspiration is enabled. */
-        extern bool INSPIRATION_ENABLED;
+        extern thread_local bool INSPIRATION_ENABLED;
         /** A ship is inspired if at least INSPIRATION_SHIP_COUNT opponent ships are within this Manhattan distance. */
-        extern int INSPIRATION_RADIUS;
+        extern thread_local int INSPIRATION_RADIUS;
         /** A ship is inspired if at least this many opponent ships are within INSPIRATION_RADIUS distance. */
-        extern int INSPIRATION_SHIP_COUNT;
+        extern thread_local int INSPIRATION_SHIP_COUNT;
         /** An inspired ship mines 1/X halite from a cell per turn instead. */
-        extern int INSPIRED_EXTRACT_RATIO;
+        extern thread_local int INSPIRED_EXTRACT_RATIO;
         /** An inspired ship that removes Y halite from a cell collects X*Y additional halite. */
-        extern double INSPIRED_BONUS_MULTIPLIER;
+        extern thread_local double INSPIRED_BONUS_MULTIPLIER;
         /** An inspired ship instead spends 1/X% halite to move. */
-        extern int INSPIRED_MOVE_COST_RATIO;
+        extern thread_local int INSPIRED_MOVE_COST_RATIO;
     }
 }
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "types.hpp"
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+
+// Containers that do not go through the global allocator once a game has warmed up
+// (see tools/alloc_check.cpp, which enforces it on recorded games).
+
+namespace hlt {
+    // Vector with inline storage for at most N elements
+    template <typename T, std::size_t N>
+    class FixedVector {
+    public:
+        void push_back(const T& value) { items_[size_++] = value; }
+        void clear() { size_ = 0; }
+
+        std::size_t size() const { return size_; }
+        bool empty() const { return size_ == 0; }
+
+        T& operator[](std::size_t i) { return items_[i]; }
+        const T& operator[](std::size_t i) const { return items_[i]; }
+        const T& front() const { return items_[0]; }
+        const T& back() const { return items_[size_ - 1]; }
+
+        T* begin() { return items_.data(); }
+        T* end() { return items_.data() + size_; }
+        const T* begin() const { return items_.data(); }
+        const T* end() const { return items_.data() + size_; }
+
+    private:
+        std::array<T, N> items_;
+        std::size_t size_ = 0;
+    };
+
+    // Free list of blocks of one size, shared by every container whose nodes have that size.
+    // Blocks are carved from chunks that are kept for the life of the process, so a
+    // container that erases and inserts entries reuses memory instead of allocating.
+    template <std::size_t BlockSize>
+    class NodePool {
+    public:
+        static void* allocate() {
+            std::lock_guard<std::mutex> lock(state().mutex);
+            State& s = state();
+            if (!s.free_list) grow(s, s.next_chunk);
+            FreeBlock* block = s.free_list;
+            s.free_list = block->next;
+            return block;
+        }
+
+        static void deallocate(void* p) {
+            std::lock_guard<std::mutex> lock(state().mutex);
+            FreeBlock* block = static_cast<FreeBlock*>(p);
+            block->next = state().free_list;
+            state().free_list = block;
+        }
+
+    private:
+        struct FreeBlock {
+            FreeBlock* next;
+        };
+
+        struct State {
+            std::mutex mutex;
+            FreeBlock* free_list = nullptr;
+            std::size_t next_chunk = 64;
+        };
+
+        static State& state() {
+            static State s;
+            return s;
+        }
+
+        // Chunks double in size, so a container growing to n entries allocates O(log n) times
+        static void grow(State& s, std::size_t blocks) {
+            char* chunk = static_cast<char*>(::operator new(blocks * BlockSize));
+            for (std::size_t i = 0; i < blocks; ++i) {
+                FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * BlockSize);
+                block->next = s.free_list;
+                s.free_list = block;
+            }
+            s.next_chunk = blocks * 2;
+        }
+    };
+
+    inline constexpr std::size_t pool_block_size(std::size_t size) {
+        return (size + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    }
+
+    // Allocator of node-based containers: single nodes come from a NodePool,
+    // arrays (hash buckets) from the global allocator
+    template <typename T>
+    struct PoolAllocator {
+        typedef T value_type;
+
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned pool node");
+
+        PoolAllocator() = default;
+        template <typename U> PoolAllocator(const PoolAllocator<U>&) {}
+
+        T* allocate(std::size_t n) {
+            if (n == 1) return static_cast<T*>(NodePool<pool_block_size(sizeof(T))>::allocate());
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t n) {
+            if (n == 1) NodePool<pool_block_size(sizeof(T))>::deallocate(p);
+            else ::operator delete(p);
+        }
+    };
+
+    template <typename T, typename U>
+    bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&) { return true; }
+    template <typename T, typename U>
+    bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&) { return false; }
+
+    template <typename Key, typename Value>
+    using PooledMap = std::unordered_map<Key, Value, std::hash<Key>, std::equal_to<Key>, PoolAllocator<std::pair<const Key, Value>>>;
+
+    template <typename Value>
+    using EntityMap = PooledMap<EntityId, Value>;
+
+    // Entity containers are sized for one ship per this many cells and player,
+    // which no game reaches in practice
+    static const int CELLS_PER_RESERVED_ENTITY = 8;
+
+    inline std::size_t entity_reserve(int width, int height) {
+        return static_cast<std::size_t>(width * height / CELLS_PER_RESERVED_ENTITY);
+    }
+
+    // Size the buckets of a PooledMap for `count` more entries and leave as many
+    // nodes on the pool's free list, so inserts up to that size do not allocate
+    template <typename Map>
+    void reserve_pooled(Map& map, std::size_t count) {
+        typedef typename Map::key_type Key;
+        map.reserve(map.size() + count);
+        const Key top = std::numeric_limits<Key>::max();
+        for (std::size_t i = 0; i < count; ++i) map.emplace(top - static_cast<Key>(i), typename Map::mapped_type());
+        for (std::size_t i = 0; i < count; ++i) map.erase(top - static_cast<Key>(i));
+    }
+}
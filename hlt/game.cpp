@@ -1,7 +1,7 @@
 #include "game.hpp"
 #include "input.hpp"
 
-#include <sstream>
+#include <cstdio>
 
 hlt::Game::Game() : turn_number(0) {
     std::ios_base::sync_with_stdio(false);
@@ -9,8 +9,7 @@ hlt::Game::Game() : turn_number(0) {
     hlt::constants::populate_constants(hlt::get_string());
 
     int num_players;
-    std::stringstream input(get_string());
-    input >> num_players >> my_id;
+    hlt::get_line() >> num_players >> my_id;
 
     log::open(my_id);
 
@@ -19,22 +18,28 @@ hlt::Game::Game() : turn_number(0) {
     }
     me = players[my_id];
     game_map = GameMap::_generate();
+
+    for (const auto& player : players) {
+        player->_reserve(entity_reserve(game_map->width, game_map->height));
+    }
 }
 
 void hlt::Game::ready(const std::string& name) {
-    std::cout << name << std::endl;
+    *game_streams().out << name << std::endl;
 }
 
 void hlt::Game::update_frame() {
-    hlt::get_sstream() >> turn_number;
-    log::log("=============== TURN " + std::to_string(turn_number) + " ================");
+    hlt::get_line() >> turn_number;
+    char banner[64];
+    std::snprintf(banner, sizeof(banner), "=============== TURN %d ================", turn_number);
+    log::log(banner);
 
     for (size_t i = 0; i < players.size(); ++i) {
         PlayerId current_player_id;
         int num_ships;
         int num_dropoffs;
         Halite halite;
-        hlt::get_sstream() >> current_player_id >> num_ships >> num_dropoffs >> halite;
+        hlt::get_line() >> current_player_id >> num_ships >> num_dropoffs >> halite;
 
         players[current_player_id]->_update(num_ships, num_dropoffs, halite);
     }
@@ -57,9 +62,10 @@ void hlt::Game::update_frame() {
 }
 
 bool hlt::Game::end_turn(const std::vector<hlt::Command>& commands) {
+    std::ostream& out = *game_streams().out;
     for (const auto& command : commands) {
-        std::cout << command << ' ';
+        out << command << ' ';
     }
-    std::cout << std::endl;
-    return std::cout.good();
+    out << std::endl;
+    return out.good();
 }
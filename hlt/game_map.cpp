@@ -1,42 +1,58 @@
 #include "game_map.hpp"
 #include "input.hpp"
 
+#include <algorithm>
+
 void hlt::GameMap::_update() {
-    for (int y = 0; y < height; ++y) {
-        for (int x = 0; x < width; ++x) {
-            cells[y][x].ship.reset();
-        }
+    for (MapCell& cell : cells) {
+        cell.ship.reset();
     }
 
+    changed_cells.clear();
+    changed_previous_halite.clear();
+    std::fill(dirty_tiles.begin(), dirty_tiles.end(), false);
+
     int update_count;
-    hlt::get_sstream() >> update_count;
+    hlt::get_line() >> update_count;
 
     for (int i = 0; i < update_count; ++i) {
         int x;
         int y;
         int halite;
-        hlt::get_sstream() >> x >> y >> halite;
+        hlt::get_line() >> x >> y >> halite;
+        changed_previous_halite.push_back(cells[y][x].halite);
         cells[y][x].halite = halite;
+
+        changed_cells.emplace_back(x, y);
+        dirty_tiles[tile_index(changed_cells.back())] = true;
     }
 }
 
 std::unique_ptr<hlt::GameMap> hlt::GameMap::_generate() {
     std::unique_ptr<hlt::GameMap> map = std::make_unique<GameMap>();
 
-    hlt::get_sstream() >> map->width >> map->height;
+    hlt::get_line() >> map->width >> map->height;
 
-    map->cells.resize((size_t)map->height);
+    map->cells.resize(map->width, map->height);
+    map->topology = shared_cell_topology(map->width, map->height);
     for (int y = 0; y < map->height; ++y) {
-        auto in = hlt::get_sstream();
+        auto in = hlt::get_line();
 
-        map->cells[y].reserve((size_t)map->width);
         for (int x = 0; x < map->width; ++x) {
             hlt::Halite halite;
             in >> halite;
 
-            map->cells[y].push_back(MapCell(x, y, halite));
+            map->cells(x, y) = MapCell(x, y, halite);
         }
     }
 
+    map->tiles_width = (map->width + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE;
+    map->tiles_height = (map->height + DIRTY_TILE_SIZE - 1) / DIRTY_TILE_SIZE;
+    map->dirty_tiles.assign((size_t)(map->tiles_width * map->tiles_height), false);
+
+    // At most every cell changes in a turn
+    map->changed_cells.reserve((size_t)(map->width * map->height));
+    map->changed_previous_halite.reserve((size_t)(map->width * map->height));
+
     return map;
 }
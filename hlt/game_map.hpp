@@ -2,18 +2,58 @@
 
 #include "types.hpp"
 #include "map_cell.hpp"
+#include "cell_grid.hpp"
+#include "cell_id.hpp"
+#include "fixed_containers.hpp"
 
 #include <vector>
 
 namespace hlt {
     struct GameMap {
+        /** Side of the square tiles tracked by dirty_tiles. */
+        static const int DIRTY_TILE_SIZE = 4;
+
         int width;
         int height;
-        std::vector<std::vector<MapCell>> cells;
+        /** cells[y][x], or cells(x, y); the memory layout is GridLayout. */
+        CellGrid<MapCell> cells;
+        /** Neighbour and distance tables of CellIds on this map size. */
+        std::shared_ptr<const CellTopology> topology;
+
+        /** Cells whose halite was updated by the engine during the last _update(). */
+        std::vector<Position> changed_cells;
+        /** Halite of each changed cell before the update (parallel to changed_cells). */
+        std::vector<Halite> changed_previous_halite;
+        /** One flag per tile, set if any cell of the tile is in changed_cells. */
+        std::vector<bool> dirty_tiles;
+        int tiles_width;
+        int tiles_height;
+
+        int tile_index(const Position& position) const {
+            return (position.y / DIRTY_TILE_SIZE) * tiles_width + position.x / DIRTY_TILE_SIZE;
+        }
 
         MapCell* at(const Position& position) {
             Position normalized = normalize(position);
-            return &cells[normalized.y][normalized.x];
+            return &cells(normalized.x, normalized.y);
+        }
+
+        MapCell* at(CellId cell) {
+            return &cells.at(cell);
+        }
+
+        /** CellId of a normalized position (every entity position is). */
+        CellId cell_id(const Position& position) const {
+            return topology->id(position);
+        }
+
+        Position position(CellId cell) const {
+            return topology->position(cell);
+        }
+
+        /** One table lookup, wrapping included. */
+        CellId neighbour(CellId cell, Direction direction) const {
+            return topology->neighbour(cell, direction);
         }
 
         MapCell* at(const Entity& entity) {
@@ -41,13 +81,17 @@ namespace hlt {
             return toroidal_dx + toroidal_dy;
         }
 
+        int calculate_distance(CellId source, CellId target) const {
+            return topology->distance(source, target);
+        }
+
         Position normalize(const Position& position) {
             const int x = ((position.x % width) + width) % width;
             const int y = ((position.y % height) + height) % height;
             return { x, y };
         }
 
-        std::vector<Direction> get_unsafe_moves(const Position& source, const Position& destination) {
+        FixedVector<Direction, 2> get_unsafe_moves(const Position& source, const Position& destination) {
             const auto& normalized_source = normalize(source);
             const auto& normalized_destination = normalize(destination);
 
@@ -56,7 +100,7 @@ namespace hlt {
             const int wrapped_dx = width - dx;
             const int wrapped_dy = height - dy;
 
-            std::vector<Direction> possible_moves;
+            FixedVector<Direction, 2> possible_moves;
 
             if (normalized_source.x < normalized_destination.x) {
                 possible_moves.push_back(dx > wrapped_dx ? Direction::WEST : Direction::EAST);
@@ -2,22 +2,66 @@
 
 #include "log.hpp"
 
+#include <cstdlib>
 #include <string>
 #include <iostream>
-#include <sstream>
 
 namespace hlt {
-    static std::string get_string() {
-        std::string result;
-        std::getline(std::cin, result);
-        if (!std::cin.good()) {
+    // Streams the game of the current thread talks to the engine through.
+    // stdin / stdout unless the thread plays a hosted game (see bot_server).
+    struct GameStreams {
+        std::istream* in = &std::cin;
+        std::ostream* out = &std::cout;
+        // Exit the process when the engine closes the connection, otherwise throw InputClosed
+        bool exit_on_close = true;
+    };
+
+    struct InputClosed {};
+
+    inline GameStreams& game_streams() {
+        thread_local GameStreams streams;
+        return streams;
+    }
+
+    static void read_line(std::string& line) {
+        std::istream& in = *game_streams().in;
+        std::getline(in, line);
+        if (!in.good()) {
             hlt::log::log("Input connection from server closed. Exiting...");
+            if (!game_streams().exit_on_close) {
+                throw InputClosed();
+            }
             exit(0);
         }
+    }
+
+    static std::string get_string() {
+        std::string result;
+        read_line(result);
         return result;
     }
 
-    static std::stringstream get_sstream() {
-        return std::stringstream(get_string());
+    // Integers of one input line, parsed in place
+    class InputLine {
+    public:
+        explicit InputLine(const char* text) : cursor_(text) {}
+
+        InputLine& operator>>(int& value) {
+            char* end;
+            value = static_cast<int>(std::strtol(cursor_, &end, 10));
+            cursor_ = end;
+            return *this;
+        }
+
+    private:
+        const char* cursor_;
+    };
+
+    // Next line of input. The line buffer is reused, so a turn's input does not
+    // allocate; the returned InputLine is valid until the next get_line call.
+    static InputLine get_line() {
+        thread_local std::string line;
+        read_line(line);
+        return InputLine(line.c_str());
     }
 }
@@ -5,48 +5,66 @@
 #include <vector>
 #include <chrono>
 
-static std::ofstream log_file;
-static std::vector<std::string> log_buffer;
-static bool has_opened = false;
+static hlt::log::Sink default_sink;
 static bool has_atexit = false;
+static thread_local hlt::log::Sink* current_sink = nullptr;
+
+static hlt::log::Sink& sink() {
+    return current_sink ? *current_sink : default_sink;
+}
 
 void dump_buffer_at_exit() {
-    if (has_opened) {
+    if (default_sink.has_opened) {
         return;
     }
 
     auto now_in_nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count();
     std::string filename = "bot-unknown-" + std::to_string(now_in_nanos) + ".log";
     std::ofstream file(filename, std::ios::trunc | std::ios::out);
-    for (const std::string& message : log_buffer) {
+    for (const std::string& message : default_sink.buffer) {
         file << message << std::endl;
     }
 }
 
+void hlt::log::use_sink(Sink* sink) {
+    current_sink = sink;
+}
+
 void hlt::log::open(int bot_id) {
-    if (has_opened) {
+    Sink& s = sink();
+    if (s.has_opened) {
         hlt::log::log("Error: log: tried to open(" + std::to_string(bot_id) + ") but we have already opened before.");
         exit(1);
     }
 
-    has_opened = true;
-    std::string filename = "bot-" + std::to_string(bot_id) + ".log";
-    log_file.open(filename, std::ios::trunc | std::ios::out);
+    s.has_opened = true;
+    std::string filename = s.prefix + "bot-" + std::to_string(bot_id) + ".log";
+    s.file.open(filename, std::ios::trunc | std::ios::out);
 
-    for (const std::string& message : log_buffer) {
-        log_file << message << std::endl;
+    for (const std::string& message : s.buffer) {
+        s.file << message << std::endl;
     }
-    log_buffer.clear();
+    s.buffer.clear();
 }
 
 void hlt::log::log(const std::string& message) {
-    if (has_opened) {
-        log_file << message << std::endl;
+    Sink& s = sink();
+    if (s.has_opened) {
+        s.file << message << std::endl;
     } else {
-        if (!has_atexit) {
+        if (&s == &default_sink && !has_atexit) {
             has_atexit = true;
             atexit(dump_buffer_at_exit);
         }
-        log_buffer.push_back(message);
+        s.buffer.push_back(message);
+    }
+}
+
+void hlt::log::log(const char* message) {
+    Sink& s = sink();
+    if (s.has_opened) {
+        s.file << message << std::endl;
+    } else {
+        log(std::string(message));
     }
 }
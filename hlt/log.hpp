@@ -1,10 +1,27 @@
 #pragma once
 
+#include <fstream>
 #include <string>
+#include <vector>
 
 namespace hlt {
     namespace log {
+        // Destination of the log of one game. The process default is used
+        // unless the thread plays a hosted game (see bot_server).
+        struct Sink {
+            std::ofstream file;
+            std::vector<std::string> buffer;
+            bool has_opened = false;
+            // Prepended to the log file name
+            std::string prefix;
+        };
+
+        // Send this thread's log to sink (nullptr: back to the process default)
+        void use_sink(Sink* sink);
+
         void open(int bot_id);
         void log(const std::string& message);
+        // Writes without building a std::string once the log file is open
+        void log(const char* message);
     }
 }
@@ -12,6 +12,8 @@ namespace hlt {
         std::shared_ptr<Ship> ship;
         std::shared_ptr<Entity> structure; // only has dropoffs and shipyards; if id is -1, then it's a shipyard, otherwise it's a dropoff
 
+        MapCell() : halite(0) {}
+
         MapCell(int x, int y, Halite halite) :
             position(x, y),
             halite(halite)
@@ -1,19 +1,84 @@
 #include "player.hpp"
 #include "input.hpp"
 
+#include <algorithm>
+
+void hlt::Player::_reserve(std::size_t entities) {
+    reserve_pooled(ships, entities);
+    reserve_pooled(dropoffs, entities / 4);
+    frame_ship_ids.reserve(entities);
+
+    // Entity objects are made up front and recycled, see _update
+    spare_ships.reserve(entities);
+    for (std::size_t i = 0; i < entities; ++i) spare_ships.push_back(std::make_shared<hlt::Ship>(id, -1, 0, 0, 0));
+    spare_dropoffs.reserve(entities / 4);
+    for (std::size_t i = 0; i < entities / 4; ++i) spare_dropoffs.push_back(std::make_shared<hlt::Dropoff>(id, -1, 0, 0));
+}
+
 void hlt::Player::_update(int num_ships, int num_dropoffs, Halite halite) {
     this->halite = halite;
 
-    ships.clear();
+    // Entities are updated in place and ships that left are kept for reuse,
+    // so a frame only allocates when a fleet grows past the reserved size
+    frame_ship_ids.clear();
     for (int i = 0; i < num_ships; ++i) {
-        std::shared_ptr<hlt::Ship> ship = hlt::Ship::_generate(id);
-        ships[ship->id] = ship;
+        EntityId ship_id;
+        int x;
+        int y;
+        Halite ship_halite;
+        hlt::get_line() >> ship_id >> x >> y >> ship_halite;
+        frame_ship_ids.push_back(ship_id);
+
+        std::shared_ptr<Ship>& ship = ships[ship_id];
+        if (!ship) {
+            // Spares are still referenced by last turn's map cells until GameMap::_update
+            auto spare = std::find_if(spare_ships.begin(), spare_ships.end(),
+                [](const std::shared_ptr<Ship>& s) { return s.use_count() == 1; });
+            if (spare != spare_ships.end()) {
+                ship = std::move(*spare);
+                *spare = std::move(spare_ships.back());
+                spare_ships.pop_back();
+            }
+            else {
+                ship = std::make_shared<hlt::Ship>(id, ship_id, x, y, ship_halite);
+            }
+        }
+        ship->owner = id;
+        ship->id = ship_id;
+        ship->position = Position(x, y);
+        ship->halite = ship_halite;
+    }
+
+    std::sort(frame_ship_ids.begin(), frame_ship_ids.end());
+    for (auto it = ships.begin(); it != ships.end(); ) {
+        if (!std::binary_search(frame_ship_ids.begin(), frame_ship_ids.end(), it->first)) {
+            spare_ships.push_back(std::move(it->second));
+            it = ships.erase(it);
+        }
+        else {
+            ++it;
+        }
     }
 
-    dropoffs.clear();
+    // Dropoffs are never destroyed
     for (int i = 0; i < num_dropoffs; ++i) {
-        std::shared_ptr<hlt::Dropoff> dropoff = hlt::Dropoff::_generate(id);
-        dropoffs[dropoff->id] = dropoff;
+        EntityId dropoff_id;
+        int x;
+        int y;
+        hlt::get_line() >> dropoff_id >> x >> y;
+
+        std::shared_ptr<hlt::Dropoff>& dropoff = dropoffs[dropoff_id];
+        if (!dropoff) {
+            if (!spare_dropoffs.empty()) {
+                dropoff = std::move(spare_dropoffs.back());
+                spare_dropoffs.pop_back();
+                dropoff->id = dropoff_id;
+                dropoff->position = Position(x, y);
+            }
+            else {
+                dropoff = std::make_shared<hlt::Dropoff>(id, dropoff_id, x, y);
+            }
+        }
     }
 }
 
@@ -21,7 +86,7 @@ std::shared_ptr<hlt::Player> hlt::Player::_generate() {
     PlayerId player_id;
     int shipyard_x;
     int shipyard_y;
-    hlt::get_sstream() >> player_id >> shipyard_x >> shipyard_y;
+    hlt::get_line() >> player_id >> shipyard_x >> shipyard_y;
 
     return std::make_shared<hlt::Player>(player_id, shipyard_x, shipyard_y);
 }
@@ -4,17 +4,18 @@
 #include "shipyard.hpp"
 #include "ship.hpp"
 #include "dropoff.hpp"
+#include "fixed_containers.hpp"
 
 #include <memory>
-#include <unordered_map>
+#include <vector>
 
 namespace hlt {
     struct Player {
         PlayerId id;
         std::shared_ptr<Shipyard> shipyard;
         Halite halite;
-        std::unordered_map<EntityId, std::shared_ptr<Ship>> ships;
-        std::unordered_map<EntityId, std::shared_ptr<Dropoff>> dropoffs;
+        EntityMap<std::shared_ptr<Ship>> ships;
+        EntityMap<std::shared_ptr<Dropoff>> dropoffs;
 
         Player(PlayerId player_id, int shipyard_x, int shipyard_y) :
             id(player_id),
@@ -22,7 +23,17 @@ namespace hlt {
             halite(0)
         {}
 
+        // Size the entity containers for a map with this many entities per player
+        void _reserve(std::size_t entities);
         void _update(int num_ships, int num_dropoffs, Halite halite);
         static std::shared_ptr<Player> _generate();
+
+    private:
+        // Unused entity objects: made by _reserve, then ships that left the game
+        // (reused once nothing else holds them)
+        std::vector<std::shared_ptr<Ship>> spare_ships;
+        std::vector<std::shared_ptr<Dropoff>> spare_dropoffs;
+        // Ship ids of the frame being read, sorted
+        std::vector<EntityId> frame_ship_ids;
     };
 }
@@ -30,7 +30,5 @@ namespace hlt {
         Command stay_still() const {
             return hlt::command::move(id, Direction::STILL);
         }
-
-        static std::shared_ptr<Ship> _generate(PlayerId player_id);
     };
 }
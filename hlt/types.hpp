@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
+
 namespace hlt {
     typedef int Halite;
     typedef int PlayerId;
     typedef int EntityId;
+    // Dense index of a map cell, y * width + x (see cell_id.hpp)
+    typedef uint16_t CellId;
 }
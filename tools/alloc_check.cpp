@@ -0,0 +1,164 @@
+// Replays recorded engine input through the bot and counts heap allocations per turn.
+// Usage: alloc_check [--trace] <transcript> [warmup_turns]
+// A transcript is everything the engine wrote to the bot's stdin during one game,
+// e.g. recorded by running the bot as `tee game.txt | ./MyBot`.
+// Exits with 1 if any turn after warmup_turns (default 20) called the global
+// operator new; --trace prints the call stack of each such allocation. The last
+// turn of the game is reported but allowed to allocate (end-of-game summaries).
+
+#include "hlt/game.hpp"
+#include "hlt/constants.hpp"
+#include "hlt/input.hpp"
+#include "hlt/log.hpp"
+
+#include "hlt/bot_controller.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+
+#ifdef __GLIBC__
+# include <execinfo.h>
+# include <unistd.h>
+#endif
+
+using namespace std;
+using namespace hlt;
+
+static std::atomic<long> allocation_count(0);
+static bool trace_allocations = false;
+static thread_local bool in_trace = false;
+
+static void on_allocation() {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+#ifdef __GLIBC__
+    if (trace_allocations && !in_trace) {
+        in_trace = true;
+        void* frames[16];
+        int depth = backtrace(frames, 16);
+        backtrace_symbols_fd(frames, depth, STDERR_FILENO);
+        write(STDERR_FILENO, "--\n", 3);
+        in_trace = false;
+    }
+#endif
+}
+
+void* operator new(std::size_t size) {
+    on_allocation();
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    on_allocation();
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    on_allocation();
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    on_allocation();
+    return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// Discards the bot's commands
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+int main(int argc, char* argv[]) {
+    int arg = 1;
+    if (arg < argc && string(argv[arg]) == "--trace") {
+        trace_allocations = true;
+        ++arg;
+    }
+    if (arg >= argc) {
+        fprintf(stderr, "usage: %s [--trace] <transcript> [warmup_turns]\n", argv[0]);
+        return 2;
+    }
+
+    ifstream file(argv[arg], ios::binary);
+    if (!file) {
+        fprintf(stderr, "cannot open %s\n", argv[arg]);
+        return 2;
+    }
+    stringstream transcript;
+    transcript << file.rdbuf();
+    int warmup = arg + 1 < argc ? stoi(argv[arg + 1]) : 20;
+
+    NullBuffer null_buffer;
+    ostream null_out(&null_buffer);
+    GameStreams& streams = game_streams();
+    streams.in = &transcript;
+    streams.out = &null_out;
+    streams.exit_on_close = false;
+
+    // The log goes next to the transcript
+    log::Sink sink;
+    sink.prefix = string(argv[arg]) + ".";
+    log::use_sink(&sink);
+
+    // Only turns after warmup are traced
+    bool tracing = trace_allocations;
+    trace_allocations = false;
+
+    mt19937 rng(1);
+    Game game;
+    BotController bot(rng);
+    bot.init(game, STARTUP_BUDGET_MS);
+    game.ready("Colinatole");
+
+    int turns = 0;
+    int failing_turns = 0;
+    long warmup_allocations = 0;
+    long steady_allocations = 0;
+    try {
+        for (;;) {
+            if (turns == warmup) trace_allocations = tracing;
+            long before = allocation_count.load();
+
+            game.update_frame();
+            const vector<Command>& command_queue = bot.play_turn(game);
+            game.end_turn(command_queue);
+            bot.speculate(game);
+
+            long allocations = allocation_count.load() - before;
+            ++turns;
+            if (turns <= warmup) {
+                warmup_allocations += allocations;
+            }
+            else if (game.turn_number == constants::MAX_TURNS) {
+                printf("turn %d (last): %ld allocations\n", game.turn_number, allocations);
+            }
+            else if (allocations > 0) {
+                steady_allocations += allocations;
+                ++failing_turns;
+                printf("turn %d: %ld allocations\n", game.turn_number, allocations);
+            }
+        }
+    }
+    catch (const InputClosed&) {
+    }
+    trace_allocations = false;
+    log::use_sink(nullptr);
+
+    printf("%d turns: %ld allocations during %d warmup turns, %ld after (%d turns allocated)\n",
+        turns, warmup_allocations, std::min(turns, warmup), steady_allocations, failing_turns);
+    return failing_turns > 0 ? 1 : 0;
+}
@@ -0,0 +1,348 @@
+// Micro-benchmark of the grid scan kernels against the scalar code they replace.
+// Usage: bench_kernels [iterations]
+
+#include "hlt/game_map.hpp"
+#include "hlt/constants.hpp"
+
+#include "hlt/bot_attraction_field.hpp"
+#include "hlt/bot_game_state.hpp"
+#include "hlt/bot_mining.hpp"
+#include "hlt/bot_precompute.hpp"
+#include "hlt/bot_simd.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+
+using namespace std;
+using namespace hlt;
+
+using Clock = std::chrono::steady_clock;
+
+static unique_ptr<GameMap> make_map(int size, mt19937& rng) {
+    unique_ptr<GameMap> map = make_unique<GameMap>();
+    map->width = size;
+    map->height = size;
+    uniform_int_distribution<int> halite(0, 1000);
+    map->cells.resize(size, size);
+    map->topology = shared_cell_topology(size, size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) map->cells(x, y) = MapCell(x, y, halite(rng));
+    }
+    map->tiles_width = (size + GameMap::DIRTY_TILE_SIZE - 1) / GameMap::DIRTY_TILE_SIZE;
+    map->tiles_height = map->tiles_width;
+    map->dirty_tiles.assign(map->tiles_width * map->tiles_height, false);
+    return map;
+}
+
+// Scalar code the kernels replace, kept verbatim for comparison
+static int baseline_count_halite_in_area(const Position& center, GameMap* game_map_ptr, int radius) {
+    int total_halite = 0;
+    for (int dy = -radius; dy <= radius; ++dy) {
+        for (int dx = -radius; dx <= radius; ++dx) {
+            Position pos = game_map_ptr->normalize(center + Position{ dx, dy });
+            total_halite += game_map_ptr->at(pos)->halite;
+        }
+    }
+    return total_halite;
+}
+
+static void baseline_add_enemy_influence(GameMap* game_map, vector<vector<uint8_t>>& enemy_count, const Position& epos) {
+    for (int dy = -INSPIRATION_RADIUS; dy <= INSPIRATION_RADIUS; ++dy) {
+        int rem = INSPIRATION_RADIUS - std::abs(dy);
+        for (int dx = -rem; dx <= rem; ++dx) {
+            Position p(epos.x + dx, epos.y + dy);
+            p = game_map->normalize(p);
+            uint8_t& c = enemy_count[p.y][p.x];
+            if (c < 255) ++c;
+        }
+    }
+}
+
+template <typename F>
+static double time_ns_per_call(int calls, F&& body) {
+    Clock::time_point start = Clock::now();
+    body();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls;
+}
+
+static void report(const string& query, const string& variant, int size, double ns, double baseline_ns, const string& note) {
+    printf("%-14s %-10s %3dx%-3d %10.1f ns/call  x%5.2f  %s\n",
+        query.c_str(), variant.c_str(), size, size, ns, baseline_ns / ns, note.c_str());
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? stoi(argv[1]) : 2000;
+
+    constants::MAX_HALITE = 1000;
+    constants::EXTRACT_RATIO = 4;
+    constants::MOVE_COST_RATIO = 10;
+
+    const SimdLevel levels[] = { SimdLevel::SCALAR, SimdLevel::SSE41, SimdLevel::AVX2 };
+    const int sizes[] = { 32, 48, 64 };
+
+    for (int size : sizes) {
+        mt19937 rng(1234 + size);
+        unique_ptr<GameMap> map = make_map(size, rng);
+        GameMap* game_map = map.get();
+
+        vector<vector<bool>> inspired(size, vector<bool>(size, false));
+        vector<vector<bool>> claimed(size, vector<bool>(size, false));
+        bernoulli_distribution inspired_draw(0.1);
+        bernoulli_distribution claimed_draw(0.02);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                inspired[y][x] = inspired_draw(rng);
+                claimed[y][x] = claimed_draw(rng);
+            }
+        }
+
+        vector<Position> probes;
+        uniform_int_distribution<int> coord(0, size - 1);
+        for (int i = 0; i < 256; ++i) probes.emplace_back(coord(rng), coord(rng));
+
+        MiningGrids grids;
+        grids.update(game_map, inspired, claimed);
+
+        // --- Mining target window --------------------------------------------------
+        int calls = iterations * static_cast<int>(probes.size());
+        volatile int sink = 0;
+        // pick_mining_target reserves its pick: undo it after each call so every call sees the same claims
+        const vector<vector<bool>> original_claims = claimed;
+        double base_ns = time_ns_per_call(calls, [&]() {
+            for (int it = 0; it < iterations; ++it) {
+                for (const auto& p : probes) {
+                    Position t = pick_mining_target(p, game_map, inspired, claimed);
+                    claimed[t.y][t.x] = original_claims[t.y][t.x];
+                    sink += t.x;
+                }
+            }
+        });
+        report("mining_window", "baseline", size, base_ns, base_ns, "pick_mining_target");
+
+        for (SimdLevel level : levels) {
+            const SimdKernels* kernels = simd_kernels_for(level);
+            if (!kernels) continue;
+
+            // Agreement with the scalar double-precision scan (claims differ slightly: >>7 vs x0.01)
+            int agree = 0;
+            for (const auto& p : probes) {
+                vector<vector<bool>> c = claimed;
+                if (scan_mining_window(*kernels, grids, p) == pick_mining_target(p, game_map, inspired, c)) ++agree;
+            }
+
+            double ns = time_ns_per_call(calls, [&]() {
+                for (int it = 0; it < iterations; ++it) {
+                    for (const auto& p : probes) sink += scan_mining_window(*kernels, grids, p).x;
+                }
+            });
+            report("mining_window", kernels->name, size, ns, base_ns,
+                "agree " + to_string(agree) + "/" + to_string(probes.size()));
+        }
+
+        // --- Score rows with every claim shift (claims, enemy territory, others) -----
+        {
+            int span = 2 * SEARCH_RADIUS + 1;
+            int lanes = static_cast<int>(probes.size()) * span;
+            vector<int32_t> halite(lanes), multiplier(lanes), shift(lanes), weight(lanes), expected(lanes), out(lanes);
+            uniform_int_distribution<int> halite_draw(0, 1000);
+            uniform_int_distribution<int> shift_draw(0, 31);
+            for (int i = 0; i < lanes; ++i) {
+                halite[i] = halite_draw(rng);
+                multiplier[i] = inspired_draw(rng) ? INSPIRED_MULTIPLIER : 1;
+                weight[i] = halite_draw(rng);
+                // Mostly the shifts the bot writes, the rest anywhere in 0..31
+                const int32_t used[] = { 0, TERRITORY_SCORE_SHIFT, CLAIM_SCORE_SHIFT };
+                shift[i] = i % 4 == 3 ? shift_draw(rng) : used[i % 3];
+            }
+            const SimdKernels* scalar = simd_kernels_for(SimdLevel::SCALAR);
+            scalar->score_row(&halite[0], &multiplier[0], &shift[0], &weight[0], lanes, MIN_TARGET_HALITE, &expected[0]);
+
+            double scalar_ns = 0.0;
+            for (SimdLevel level : levels) {
+                const SimdKernels* kernels = simd_kernels_for(level);
+                if (!kernels) continue;
+
+                // One call per row of the window width, like scan_mining_window
+                double ns = time_ns_per_call(calls, [&]() {
+                    for (int it = 0; it < iterations; ++it) {
+                        for (int i = 0; i + span <= lanes; i += span) {
+                            kernels->score_row(&halite[i], &multiplier[i], &shift[i], &weight[i], span, MIN_TARGET_HALITE, &out[i]);
+                        }
+                        sink += out[it % lanes];
+                    }
+                });
+                if (level == SimdLevel::SCALAR) scalar_ns = ns;
+                report("score_row", kernels->name, size, ns, scalar_ns, string(out == expected ? "exact" : "MISMATCH") + ", shifts 0..31");
+            }
+        }
+
+        // --- Square window sum (dropoff planner) -----------------------------------
+        base_ns = time_ns_per_call(calls, [&]() {
+            for (int it = 0; it < iterations; ++it) {
+                for (const auto& p : probes) sink += baseline_count_halite_in_area(p, game_map, DROPOFF_SCAN_RADIUS);
+            }
+        });
+        report("window_sum", "baseline", size, base_ns, base_ns, "count_halite_in_area");
+
+        for (SimdLevel level : levels) {
+            const SimdKernels* kernels = simd_kernels_for(level);
+            if (!kernels) continue;
+
+            bool exact = true;
+            for (const auto& p : probes) {
+                if (kernels->window_sum(grids.halite, p.x, p.y, DROPOFF_SCAN_RADIUS) != baseline_count_halite_in_area(p, game_map, DROPOFF_SCAN_RADIUS)) exact = false;
+            }
+
+            double ns = time_ns_per_call(calls, [&]() {
+                for (int it = 0; it < iterations; ++it) {
+                    for (const auto& p : probes) sink += static_cast<int>(kernels->window_sum(grids.halite, p.x, p.y, DROPOFF_SCAN_RADIUS));
+                }
+            });
+            report("window_sum", kernels->name, size, ns, base_ns, exact ? "exact" : "MISMATCH");
+        }
+
+        // --- Inspiration diamonds (one stamp per enemy + fold) ----------------------
+        int turns = iterations / 10 + 1;
+        vector<vector<uint8_t>> enemy_count(size, vector<uint8_t>(size, 0));
+        base_ns = time_ns_per_call(turns, [&]() {
+            for (int t = 0; t < turns; ++t) {
+                for (auto& r : enemy_count) std::fill(r.begin(), r.end(), 0);
+                for (const auto& p : probes) baseline_add_enemy_influence(game_map, enemy_count, p);
+            }
+        });
+        report("diamond_turn", "baseline", size, base_ns, base_ns, "256 enemies");
+
+        for (SimdLevel level : levels) {
+            const SimdKernels* kernels = simd_kernels_for(level);
+            if (!kernels) continue;
+
+            PaddedGrid counts;
+            counts.resize(size, size, INSPIRATION_RADIUS);
+            double ns = time_ns_per_call(turns, [&]() {
+                for (int t = 0; t < turns; ++t) {
+                    counts.fill(0);
+                    for (const auto& p : probes) kernels->diamond_add(counts, p.x, p.y, INSPIRATION_RADIUS);
+                    counts.fold_padding();
+                }
+            });
+
+            bool exact = true;
+            for (int y = 0; y < size; ++y) {
+                for (int x = 0; x < size; ++x) {
+                    if (std::min(counts.get(x, y), 255) != enemy_count[y][x]) exact = false;
+                }
+            }
+            report("diamond_turn", kernels->name, size, ns, base_ns, exact ? "exact" : "MISMATCH");
+        }
+
+        // --- Attraction field vs per-ship window scans --------------------------------
+        {
+            AttractionField field;
+            int updates = iterations / 10 + 1;
+            double field_ns = time_ns_per_call(updates, [&]() {
+                for (int t = 0; t < updates; ++t) {
+                    field.update(game_map, inspired);
+                    sink += field.peak_count();
+                }
+            });
+            report("field_update", simd_kernels().name, size, field_ns, field_ns, to_string(field.peak_count()) + " peaks");
+
+            double peak_ns = time_ns_per_call(calls, [&]() {
+                for (int it = 0; it < iterations; ++it) {
+                    for (const auto& p : probes) sink += field.peak(p).x;
+                }
+            });
+
+            // One turn of targeting for a fleet: field update + O(1) lookups vs one window scan per ship
+            const SimdKernels& kernels = simd_kernels();
+            double scan_ns = time_ns_per_call(calls, [&]() {
+                for (int it = 0; it < iterations; ++it) {
+                    for (const auto& p : probes) sink += scan_mining_window(kernels, grids, p).x;
+                }
+            });
+            for (int fleet : { 25, 100, 200 }) {
+                double scans = scan_ns * fleet;
+                double lookups = field_ns + peak_ns * fleet;
+                report("fleet_turn", "field", size, lookups, scans,
+                    to_string(fleet) + " ships vs " + kernels.name + " scans");
+            }
+        }
+
+        // --- Lookahead state: snapshot / apply / undo -------------------------------
+        {
+            StartupTables tables;
+            tables.width = size;
+            tables.height = size;
+            tables.geometry = shared_cell_topology(size, size);
+            tables.extraction = shared_extraction_tables();
+
+            Player me(0, size / 2, size / 2);
+            uniform_int_distribution<int> cargo(0, 900);
+            const int fleet = 64;
+            for (int i = 0; i < fleet; ++i) {
+                const Position& p = probes[i];
+                me.ships.emplace(i, make_shared<Ship>(0, i, p.x, p.y, cargo(rng)));
+            }
+
+            StateTileStore store;
+            GameState root;
+            root.load(*game_map, me, tables, store);
+            const uint64_t root_hash = root.hash();
+            GameState child;
+            StateUndo undo;
+            Direction moves[fleet];
+
+            // Snapshot of the root, one ship turn, undo, and the cloned tiles released
+            int cycles = iterations * 64;
+            bool exact = true;
+            double ns = time_ns_per_call(cycles, [&]() {
+                for (int c = 0; c < cycles; ++c) {
+                    size_t mark = store.mark();
+                    child.assign(root);
+                    int slot = c % fleet;
+                    child.step_ship(slot, c & 4 ? Direction::STILL : ALL_CARDINALS[c & 3], undo);
+                    child.undo(undo);
+                    if (child.hash() != root_hash) exact = false;
+                    store.release(mark);
+                }
+            });
+            report("state_cycle", "cow", size, ns, ns,
+                to_string(static_cast<int>(1e6 / ns)) + " cycles/ms, " + (exact ? "exact" : "MISMATCH"));
+
+            // Whole-fleet turn (with collisions) and its undo on one state
+            int steps = iterations * 4;
+            exact = true;
+            ns = time_ns_per_call(steps, [&]() {
+                for (int c = 0; c < steps; ++c) {
+                    for (int i = 0; i < fleet; ++i) moves[i] = (c + i) % 5 == 4 ? Direction::STILL : ALL_CARDINALS[(c + i) % 5];
+                    root.step(moves, undo);
+                    root.undo(undo);
+                    if (root.hash() != root_hash) exact = false;
+                }
+            });
+            report("state_step", "fleet", size, ns, ns,
+                to_string(fleet) + " ships, " + (exact ? "exact" : "MISMATCH"));
+
+            // Mine-here versus go rollouts, as run for a ship about to leave its cell
+            vector<StateUndo> undo_stack;
+            int plans = iterations * 4;
+            ns = time_ns_per_call(plans, [&]() {
+                for (int c = 0; c < plans; ++c) {
+                    int slot = c % fleet;
+                    Position target = probes[(c + 7) % probes.size()];
+                    sink += static_cast<int>(best_mining_plan_move(root, slot, target, ROLLOUT_DEPTH, undo_stack));
+                }
+            });
+            report("mining_plan", "rollout", size, ns, ns, "depth " + to_string(ROLLOUT_DEPTH));
+        }
+
+        (void)sink;
+        printf("\n");
+    }
+
+    return 0;
+}
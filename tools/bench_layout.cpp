@@ -0,0 +1,227 @@
+// Micro-benchmark of the cell grid layouts (see hlt/cell_grid.hpp): the window
+// queries of the bot run against row-major and tiled storage of the same map,
+// both for the map's own cells (MapCell, as read through GameMap) and for a
+// dense grid of int32 halite.
+// Usage: bench_layout [iterations]
+//
+// The bot is built with one layout (cmake -DTILED_GRIDS=ON for the tiled one);
+// this tool instantiates both.
+
+#include "hlt/cell_grid.hpp"
+#include "hlt/map_cell.hpp"
+
+#include "hlt/bot_config.hpp"
+#include "hlt/bot_mining.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+using namespace hlt;
+
+using Clock = std::chrono::steady_clock;
+
+static int halite_of(const MapCell& cell) { return cell.halite; }
+static int halite_of(int32_t value) { return value; }
+
+// Wrapped coordinate of every offset within `pad` of the map: wrap[c + pad]
+static vector<int> wrap_table(int size, int pad) {
+    vector<int> wrap(size + 2 * pad);
+    for (int c = -pad; c < size + pad; ++c) wrap[c + pad] = ((c % size) + size) % size;
+    return wrap;
+}
+
+struct Probes {
+    int size;
+    int pad;
+    vector<int> wrap;
+    vector<Position> points;
+};
+
+// Halite in the square of the given radius (count_halite_in_area)
+template <typename Grid>
+static int window_sum(const Grid& grid, const Probes& probes, const Position& center, int radius) {
+    const int* wrap = &probes.wrap[probes.pad];
+    int total = 0;
+    for (int dy = -radius; dy <= radius; ++dy) {
+        auto row = grid[wrap[center.y + dy]];
+        for (int dx = -radius; dx <= radius; ++dx) total += halite_of(row[wrap[center.x + dx]]);
+    }
+    return total;
+}
+
+// Best halite / (distance + 1) in the SEARCH_RADIUS window (pick_mining_target without claims)
+template <typename Grid>
+static Position mining_window(const Grid& grid, const Probes& probes, const Position& origin) {
+    const int* wrap = &probes.wrap[probes.pad];
+    Position best = origin;
+    double best_score = -1.0;
+    for (int dy = -SEARCH_RADIUS; dy <= SEARCH_RADIUS; ++dy) {
+        int y = wrap[origin.y + dy];
+        auto row = grid[y];
+        for (int dx = -SEARCH_RADIUS; dx <= SEARCH_RADIUS; ++dx) {
+            int x = wrap[origin.x + dx];
+            double score = static_cast<double>(halite_of(row[x])) / (std::abs(dx) + std::abs(dy) + 1);
+            if (score > best_score) {
+                best_score = score;
+                best = Position(x, y);
+            }
+        }
+    }
+    return best;
+}
+
+// +1 on every cell within manhattan INSPIRATION_RADIUS (add_enemy_influence)
+template <typename Counts>
+static void diamond_add(Counts& counts, const Probes& probes, const Position& center) {
+    const int* wrap = &probes.wrap[probes.pad];
+    for (int dy = -INSPIRATION_RADIUS; dy <= INSPIRATION_RADIUS; ++dy) {
+        int rem = INSPIRATION_RADIUS - std::abs(dy);
+        auto row = counts[wrap[center.y + dy]];
+        for (int dx = -rem; dx <= rem; ++dx) {
+            uint8_t& c = row[wrap[center.x + dx]];
+            if (c < 255) ++c;
+        }
+    }
+}
+
+template <typename F>
+static double time_ns_per_call(int calls, F&& body) {
+    Clock::time_point start = Clock::now();
+    body();
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls;
+}
+
+static void report(const string& query, const string& variant, int size, double ns, double baseline_ns, const string& note) {
+    printf("%-14s %-18s %3dx%-3d %10.1f ns/call  x%5.2f  %s\n",
+        query.c_str(), variant.c_str(), size, size, ns, baseline_ns / ns, note.c_str());
+}
+
+static void set_cell(MapCell& cell, int x, int y, int halite) { cell = MapCell(x, y, halite); }
+static void set_cell(int32_t& cell, int x, int y, int halite) { (void)x; (void)y; cell = halite; }
+
+// Every query on one cell type and layout; the checksums must match across layouts
+struct LayoutResult {
+    double window_ns = 0.0;
+    double mining_ns = 0.0;
+    double diamond_ns = 0.0;
+    double pass_ns = 0.0;
+    long window_check = 0;
+    long mining_check = 0;
+    long diamond_check = 0;
+    long pass_check = 0;
+};
+
+template <typename Cell, typename Layout>
+static LayoutResult run_layout(const vector<int>& halite, const Probes& probes, int iterations) {
+    int size = probes.size;
+    CellGrid<Cell, Layout> grid;
+    grid.resize(size, size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) set_cell(grid(x, y), x, y, halite[y * size + x]);
+    }
+
+    LayoutResult result;
+    int calls = iterations * static_cast<int>(probes.points.size());
+    volatile long sink = 0;
+
+    result.window_ns = time_ns_per_call(calls, [&]() {
+        for (int it = 0; it < iterations; ++it) {
+            for (const auto& p : probes.points) sink += window_sum(grid, probes, p, DROPOFF_SCAN_RADIUS);
+        }
+    });
+    for (const auto& p : probes.points) result.window_check += window_sum(grid, probes, p, DROPOFF_SCAN_RADIUS);
+
+    result.mining_ns = time_ns_per_call(calls, [&]() {
+        for (int it = 0; it < iterations; ++it) {
+            for (const auto& p : probes.points) sink += mining_window(grid, probes, p).x;
+        }
+    });
+    for (const auto& p : probes.points) {
+        Position t = mining_window(grid, probes, p);
+        result.mining_check = result.mining_check * 31 + t.y * size + t.x;
+    }
+
+    // One turn of inspiration counts: clear, then one stamp per enemy
+    int turns = iterations / 10 + 1;
+    CellGrid<uint8_t, Layout> counts;
+    counts.resize(size, size);
+    result.diamond_ns = time_ns_per_call(turns, [&]() {
+        for (int t = 0; t < turns; ++t) {
+            std::fill(counts.begin(), counts.end(), 0);
+            for (const auto& p : probes.points) diamond_add(counts, probes, p);
+        }
+    });
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) result.diamond_check = result.diamond_check * 31 + counts(x, y);
+    }
+
+    // Whole map read row by row (per-turn syncs and full scans)
+    int passes = iterations;
+    result.pass_ns = time_ns_per_call(passes, [&]() {
+        for (int t = 0; t < passes; ++t) {
+            long total = 0;
+            for (int y = 0; y < size; ++y) {
+                auto row = grid[y];
+                for (int x = 0; x < size; ++x) total += halite_of(row[x]);
+            }
+            sink += total;
+        }
+    });
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) result.pass_check += halite_of(grid(x, y));
+    }
+
+    (void)sink;
+    return result;
+}
+
+template <typename Cell>
+static void compare_layouts(const char* cell_name, const vector<int>& halite, const Probes& probes, int iterations) {
+    LayoutResult rows = run_layout<Cell, RowMajorLayout>(halite, probes, iterations);
+    LayoutResult tiles = run_layout<Cell, TiledLayout>(halite, probes, iterations);
+    int size = probes.size;
+    string row_name = string(cell_name) + " " + RowMajorLayout::name();
+    string tile_name = string(cell_name) + " " + TiledLayout::name();
+
+    report("window_sum", row_name, size, rows.window_ns, rows.window_ns, "count_halite_in_area");
+    report("window_sum", tile_name, size, tiles.window_ns, rows.window_ns, tiles.window_check == rows.window_check ? "exact" : "MISMATCH");
+    report("mining_window", row_name, size, rows.mining_ns, rows.mining_ns, "pick_mining_target");
+    report("mining_window", tile_name, size, tiles.mining_ns, rows.mining_ns, tiles.mining_check == rows.mining_check ? "exact" : "MISMATCH");
+    report("diamond_turn", row_name, size, rows.diamond_ns, rows.diamond_ns, to_string(probes.points.size()) + " enemies");
+    report("diamond_turn", tile_name, size, tiles.diamond_ns, rows.diamond_ns, tiles.diamond_check == rows.diamond_check ? "exact" : "MISMATCH");
+    report("map_pass", row_name, size, rows.pass_ns, rows.pass_ns, "every cell, row by row");
+    report("map_pass", tile_name, size, tiles.pass_ns, rows.pass_ns, tiles.pass_check == rows.pass_check ? "exact" : "MISMATCH");
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? stoi(argv[1]) : 2000;
+
+    printf("bot built with the %s layout\n\n", GridLayout::name());
+
+    const int sizes[] = { 32, 40, 48, 56, 64 };
+    for (int size : sizes) {
+        mt19937 rng(1234 + size);
+        uniform_int_distribution<int> draw(0, 1000);
+        vector<int> halite(static_cast<size_t>(size) * size);
+        for (int& h : halite) h = draw(rng);
+
+        Probes probes;
+        probes.size = size;
+        probes.pad = std::max(SEARCH_RADIUS, std::max(DROPOFF_SCAN_RADIUS, INSPIRATION_RADIUS));
+        probes.wrap = wrap_table(size, probes.pad);
+        uniform_int_distribution<int> coord(0, size - 1);
+        for (int i = 0; i < 256; ++i) probes.points.emplace_back(coord(rng), coord(rng));
+
+        compare_layouts<MapCell>("MapCell", halite, probes, iterations);
+        compare_layouts<int32_t>("int32", halite, probes, iterations);
+        printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,285 @@
+// Macro benchmark of BotController::play_turn on synthetic games (see tools/scenario.hpp).
+// Usage:
+//   bench_scale [turns] [players]
+//       sweeps map size x ships per player for every fleet layout and prints, per
+//       configuration, the per-turn latency (mean / p50 / p99 / max) and heap memory
+//       (after init, and the peak while playing)
+//   bench_scale --write <file> <size> <players> <ships> <clustered|spread|pile_up> [turns] [seed]
+//       writes one scenario as a transcript (e.g. for tools/alloc_check)
+//   bench_scale --policy [hidden] [radius]
+//       times one batch of the learned move policy (random weights) per fleet size
+// Logs go to bench_scale.bot-<id>.log in the working directory.
+
+#include "hlt/game.hpp"
+#include "hlt/constants.hpp"
+#include "hlt/input.hpp"
+#include "hlt/log.hpp"
+
+#include "hlt/bot_controller.hpp"
+
+#include "tools/scenario.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __GLIBC__
+# include <malloc.h>
+#endif
+
+using namespace std;
+using namespace hlt;
+
+using Clock = std::chrono::steady_clock;
+
+// Live heap bytes, from the size malloc actually reserved for each block
+static std::atomic<long long> live_bytes(0);
+static std::atomic<long long> peak_bytes(0);
+
+static size_t block_size(void* p) {
+#ifdef __GLIBC__
+    return malloc_usable_size(p);
+#else
+    (void)p;
+    return 0;
+#endif
+}
+
+static void* counted_malloc(std::size_t size) {
+    void* p = std::malloc(size ? size : 1);
+    if (!p) return nullptr;
+    long long live = live_bytes.fetch_add(static_cast<long long>(block_size(p))) + static_cast<long long>(block_size(p));
+    long long peak = peak_bytes.load();
+    while (live > peak && !peak_bytes.compare_exchange_weak(peak, live)) {
+    }
+    return p;
+}
+
+static void counted_free(void* p) {
+    if (!p) return;
+    live_bytes.fetch_sub(static_cast<long long>(block_size(p)));
+    std::free(p);
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = counted_malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* p = counted_malloc(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return counted_malloc(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return counted_malloc(size); }
+void operator delete(void* p) noexcept { counted_free(p); }
+void operator delete[](void* p) noexcept { counted_free(p); }
+void operator delete(void* p, std::size_t) noexcept { counted_free(p); }
+void operator delete[](void* p, std::size_t) noexcept { counted_free(p); }
+
+// Discards the bot's commands
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+struct RunResult {
+    int turns = 0;
+    int ships = 0;
+    double mean_ms = 0.0;
+    double p50_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+    double init_kb = 0.0;
+    double peak_kb = 0.0;
+};
+
+static RunResult run(const string& transcript_text) {
+    stringstream transcript(transcript_text);
+    NullBuffer null_buffer;
+    ostream null_out(&null_buffer);
+    GameStreams& streams = game_streams();
+    streams.in = &transcript;
+    streams.out = &null_out;
+    streams.exit_on_close = false;
+
+    log::Sink sink;
+    sink.prefix = "bench_scale.";
+    log::use_sink(&sink);
+
+    RunResult result;
+    vector<double> turn_ms;
+    long long base = live_bytes.load();
+    {
+        mt19937 rng(1);
+        Game game;
+        BotController bot(rng);
+        bot.init(game, STARTUP_BUDGET_MS);
+        game.ready("Colinatole");
+        result.init_kb = (live_bytes.load() - base) / 1024.0;
+        peak_bytes.store(live_bytes.load());
+
+        try {
+            for (;;) {
+                game.update_frame();
+                Clock::time_point start = Clock::now();
+                const vector<Command>& command_queue = bot.play_turn(game);
+                turn_ms.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+                game.end_turn(command_queue);
+                bot.speculate(game);
+                result.ships = static_cast<int>(game.me->ships.size());
+            }
+        }
+        catch (const InputClosed&) {
+        }
+        result.peak_kb = (peak_bytes.load() - base) / 1024.0;
+    }
+    log::use_sink(nullptr);
+
+    result.turns = static_cast<int>(turn_ms.size());
+    if (!turn_ms.empty()) {
+        double total = 0.0;
+        for (double ms : turn_ms) total += ms;
+        result.mean_ms = total / turn_ms.size();
+        sort(turn_ms.begin(), turn_ms.end());
+        result.p50_ms = turn_ms[turn_ms.size() / 2];
+        result.p99_ms = turn_ms[std::min(turn_ms.size() - 1, turn_ms.size() * 99 / 100)];
+        result.max_ms = turn_ms.back();
+    }
+    return result;
+}
+
+// Random weights in the policy file format
+static vector<uint8_t> random_policy(int radius, int hidden, mt19937& rng) {
+    PolicyFileHeader header = { POLICY_MAGIC, POLICY_VERSION, static_cast<uint16_t>(radius),
+        POLICY_CHANNEL_COUNT, POLICY_SCALAR_COUNT, static_cast<uint16_t>(hidden) };
+    size_t floats = static_cast<size_t>(policy_input_count(radius)) * hidden + hidden + POLICY_MOVES * hidden + POLICY_MOVES;
+    vector<uint8_t> bytes(sizeof(header) + floats * sizeof(float));
+    memcpy(bytes.data(), &header, sizeof(header));
+    normal_distribution<float> weight(0.0f, 0.1f);
+    for (size_t i = 0; i < floats; ++i) {
+        float w = weight(rng);
+        memcpy(&bytes[sizeof(header) + i * sizeof(float)], &w, sizeof(w));
+    }
+    return bytes;
+}
+
+static int bench_policy(int hidden, int radius) {
+    const int fleets[] = { 10, 50, 100, 200, 300 };
+    const int batches = 200;
+    mt19937 rng(1);
+    MovePolicy policy;
+    if (!policy.parse(random_policy(radius, hidden, rng))) {
+        fprintf(stderr, "invalid policy shape\n");
+        return 1;
+    }
+
+    printf("%-8s %5s %6s %6s %12s %12s\n", "kernels", "ships", "radius", "hidden", "us/batch", "us/ship");
+    for (int ships : fleets) {
+        log::Sink sink;
+        sink.prefix = "bench_scale.";
+        log::use_sink(&sink);
+        ScenarioConfig config;
+        config.size = 64;
+        config.players = 4;
+        config.ships_per_player = ships;
+        config.turns = 1;
+        stringstream transcript;
+        Scenario(config).write(transcript);
+        GameStreams& streams = game_streams();
+        streams.in = &transcript;
+        streams.exit_on_close = false;
+
+        Game game;
+        game.update_frame();
+        policy.reserve(game.me->ships.size());
+        policy.evaluate(game);
+        Clock::time_point start = Clock::now();
+        for (int b = 0; b < batches; ++b) policy.evaluate(game);
+        double us = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / batches;
+        printf("%-8s %5d %6d %6d %12.1f %12.3f\n", simd_kernels().name, static_cast<int>(game.me->ships.size()),
+            radius, hidden, us, us / game.me->ships.size());
+        fflush(stdout);
+        log::use_sink(nullptr);
+    }
+    return 0;
+}
+
+static bool parse_layout(const string& name, FleetLayout& layout) {
+    for (FleetLayout l : { FleetLayout::CLUSTERED, FleetLayout::SPREAD, FleetLayout::PILE_UP }) {
+        if (name == fleet_layout_name(l)) {
+            layout = l;
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--write") {
+        ScenarioConfig config;
+        if (argc < 7 || !parse_layout(argv[6], config.layout)) {
+            fprintf(stderr, "usage: %s --write <file> <size> <players> <ships> <clustered|spread|pile_up> [turns] [seed]\n", argv[0]);
+            return 2;
+        }
+        config.size = stoi(argv[3]);
+        config.players = stoi(argv[4]);
+        config.ships_per_player = stoi(argv[5]);
+        if (argc > 7) config.turns = stoi(argv[7]);
+        if (argc > 8) config.seed = static_cast<uint32_t>(stoul(argv[8]));
+
+        ofstream out(argv[2], ios::binary);
+        Scenario(config).write(out);
+        return out ? 0 : 1;
+    }
+
+    if (argc > 1 && string(argv[1]) == "--policy") {
+        return bench_policy(argc > 2 ? stoi(argv[2]) : 32, argc > 3 ? stoi(argv[3]) : 4);
+    }
+
+    int turns = argc > 1 ? stoi(argv[1]) : 30;
+    int players = argc > 2 ? stoi(argv[2]) : 4;
+
+    const int sizes[] = { 32, 48, 64, 96, 128 };
+    const int fleets[] = { 10, 50, 100, 200, 300 };
+
+    printf("%-9s %7s %5s %5s %9s %9s %9s %9s %10s %10s\n",
+        "layout", "map", "ships", "turns", "mean ms", "p50 ms", "p99 ms", "max ms", "init KB", "peak KB");
+    for (FleetLayout layout : { FleetLayout::CLUSTERED, FleetLayout::SPREAD, FleetLayout::PILE_UP }) {
+        for (int size : sizes) {
+            for (int ships : fleets) {
+                // Each player owns 1/players of the map; keep fleets to at most half of it
+                if (ships * players * 2 > size * size) continue;
+
+                ScenarioConfig config;
+                config.size = size;
+                config.players = players;
+                config.ships_per_player = ships;
+                config.layout = layout;
+                config.turns = turns;
+                config.seed = static_cast<uint32_t>(size * 1000 + ships);
+
+                stringstream transcript;
+                Scenario(config).write(transcript);
+                RunResult r = run(transcript.str());
+
+                printf("%-9s %3dx%-3d %5d %5d %9.3f %9.3f %9.3f %9.3f %10.0f %10.0f\n",
+                    fleet_layout_name(layout), size, size, r.ships, r.turns,
+                    r.mean_ms, r.p50_ms, r.p99_ms, r.max_ms, r.init_kb, r.peak_kb);
+                fflush(stdout);
+            }
+        }
+    }
+    return 0;
+}
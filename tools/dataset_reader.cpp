@@ -0,0 +1,125 @@
+// Reads a training dataset written with WRITE_DATASET (see hlt/bot_dataset.hpp).
+// Usage:
+//   dataset_reader <file> summary
+//   dataset_reader <file> rows <game> <turn>
+//   dataset_reader <file> crop <game> <turn> <ship_id>
+// The file is streamed batch by batch (see tools/dataset_reader.hpp), never loaded whole.
+
+#include "tools/dataset_reader.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const char* action_name(uint8_t action) {
+    static const char* names[] = { "n", "s", "e", "w", "o", "c" };
+    return action <= DATASET_CONSTRUCT ? names[action] : "-";
+}
+
+struct GameSummary {
+    DatasetGameHeader header;
+    int turns = 0;
+    long rows = 0;
+    long actions[DATASET_CONSTRUCT + 2] = {}; // last: no command
+};
+
+static void print_rows(const DatasetBatch& batch) {
+    printf("turn %u  halite %u  rows %u\n", batch.header.turn, batch.header.halite, batch.header.rows);
+    printf("%6s %7s %7s %5s %4s %-9s %s\n", "ship", "pos", "target", "cargo", "dist", "status", "action");
+    for (int row = 0; row < batch.rows(); ++row) {
+        printf("%6u %3u,%-3u %3u,%-3u %5u %4u %-9s %s\n",
+            batch.get<uint32_t>(DATASET_SHIP_ID, row),
+            batch.get<uint16_t>(DATASET_X, row), batch.get<uint16_t>(DATASET_Y, row),
+            batch.get<uint16_t>(DATASET_TARGET_X, row), batch.get<uint16_t>(DATASET_TARGET_Y, row),
+            batch.get<uint16_t>(DATASET_CARGO, row), batch.get<uint16_t>(DATASET_DEPOSIT_DISTANCE, row),
+            batch.get<uint8_t>(DATASET_STATUS, row) == static_cast<uint8_t>(ShipState::RETURNING) ? "returning" : "mining",
+            action_name(batch.get<uint8_t>(DATASET_ACTION, row)));
+    }
+}
+
+// Halite of every crop cell, marked A (ours), E (enemy) or * (inspired)
+static void print_crop(const DatasetBatch& batch, int row) {
+    int side = 2 * batch.game->radius + 1;
+    for (int dy = 0; dy < side; ++dy) {
+        for (int dx = 0; dx < side; ++dx) {
+            int cell = dy * side + dx;
+            uint8_t flags = batch.flags(row, cell);
+            char mark = flags & DATASET_ALLY ? 'A' : flags & DATASET_ENEMY ? 'E' : flags & DATASET_INSPIRED ? '*' : ' ';
+            printf("%5u%c", batch.halite(row, cell), mark);
+        }
+        printf("\n");
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <file> summary | rows <game> <turn> | crop <game> <turn> <ship_id>\n", argv[0]);
+        return 2;
+    }
+
+    DatasetStream stream;
+    if (!stream.open(argv[1])) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    string query = argv[2];
+    DatasetBatch batch;
+
+    if (query == "summary") {
+        vector<GameSummary> games;
+        while (stream.next(batch)) {
+            if (static_cast<int>(games.size()) <= batch.game_index) {
+                games.resize(batch.game_index + 1);
+                games.back().header = *batch.game;
+            }
+            GameSummary& game = games[batch.game_index];
+            ++game.turns;
+            game.rows += batch.rows();
+            for (int row = 0; row < batch.rows(); ++row) {
+                uint8_t action = batch.get<uint8_t>(DATASET_ACTION, row);
+                ++game.actions[action <= DATASET_CONSTRUCT ? action : DATASET_CONSTRUCT + 1];
+            }
+        }
+        for (size_t g = 0; g < games.size(); ++g) {
+            const GameSummary& game = games[g];
+            printf("game %zu: %ux%u, player %u of %u, radius %u, %d turns, %ld rows, actions",
+                g, game.header.width, game.header.height, game.header.my_id, game.header.num_players,
+                game.header.radius, game.turns, game.rows);
+            for (int a = 0; a <= DATASET_CONSTRUCT + 1; ++a) {
+                printf(" %s=%ld", a <= DATASET_CONSTRUCT ? action_name(static_cast<uint8_t>(a)) : "-", game.actions[a]);
+            }
+            printf("\n");
+        }
+        return 0;
+    }
+
+    if (argc < 5 || (query == "crop" && argc < 6)) {
+        fprintf(stderr, "missing arguments for %s\n", query.c_str());
+        return 2;
+    }
+    int game = stoi(argv[3]);
+    uint32_t turn = static_cast<uint32_t>(stoul(argv[4]));
+    while (stream.next(batch)) {
+        if (batch.game_index != game || batch.header.turn != turn) continue;
+        if (query == "rows") {
+            print_rows(batch);
+            return 0;
+        }
+        if (query == "crop") {
+            uint32_t ship = static_cast<uint32_t>(stoul(argv[5]));
+            for (int row = 0; row < batch.rows(); ++row) {
+                if (batch.get<uint32_t>(DATASET_SHIP_ID, row) != ship) continue;
+                print_crop(batch, row);
+                return 0;
+            }
+            fprintf(stderr, "no ship %u on turn %u\n", ship, turn);
+            return 1;
+        }
+        fprintf(stderr, "unknown query %s\n", query.c_str());
+        return 2;
+    }
+    fprintf(stderr, "no turn %u in game %d\n", turn, game);
+    return 1;
+}
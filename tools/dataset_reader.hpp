@@ -0,0 +1,97 @@
+#pragma once
+
+// Streams a training dataset (see hlt/bot_dataset.hpp) one batch at a time:
+// only the current record is held in memory, so files of any size can be read
+// sequentially, e.g. to feed a training loop.
+
+#include "hlt/bot_dataset.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+struct DatasetBatch {
+    const DatasetGameHeader* game = nullptr; // Header of the game the batch belongs to
+    int game_index = -1;
+    DatasetBatchHeader header;
+    const uint8_t* payload = nullptr;
+    array<size_t, DATASET_COLUMN_COUNT + 1> columns;
+
+    int rows() const { return header.rows; }
+    int crop_cells() const { return (2 * game->radius + 1) * (2 * game->radius + 1); }
+
+    const uint8_t* column(DatasetColumn c) const { return payload + columns[c]; }
+
+    // Value of a scalar column
+    template <typename T>
+    T get(DatasetColumn c, int row) const {
+        T value;
+        std::memcpy(&value, column(c) + static_cast<size_t>(row) * sizeof(T), sizeof(T));
+        return value;
+    }
+
+    uint16_t halite(int row, int cell) const {
+        return get<uint16_t>(DATASET_HALITE_CROP, row * crop_cells() + cell);
+    }
+    uint8_t flags(int row, int cell) const { return column(DATASET_FLAGS_CROP)[row * crop_cells() + cell]; }
+};
+
+class DatasetStream {
+public:
+    DatasetStream() = default;
+    DatasetStream(const DatasetStream&) = delete;
+    DatasetStream& operator=(const DatasetStream&) = delete;
+    ~DatasetStream() {
+        if (file_) std::fclose(file_);
+    }
+
+    bool open(const char* path) {
+        file_ = std::fopen(path, "rb");
+        return file_ != nullptr;
+    }
+
+    // Next batch, false at the end of the file (or on a truncated or corrupt record).
+    // The batch stays valid until the next call.
+    bool next(DatasetBatch& batch) {
+        for (;;) {
+            RecordHeader record;
+            if (std::fread(&record, sizeof(record), 1, file_) != 1) return false;
+            if (record.size < sizeof(record)) return corrupt();
+            buffer_.resize(record.size - sizeof(record));
+            if (!buffer_.empty() && std::fread(buffer_.data(), buffer_.size(), 1, file_) != 1) return corrupt();
+
+            if (record.magic == DATASET_GAME_MAGIC) {
+                if (buffer_.size() < sizeof(DatasetGameHeader)) return corrupt();
+                std::memcpy(&game_, buffer_.data(), sizeof(game_));
+                if (game_.version != DATASET_VERSION || game_.column_count != DATASET_COLUMN_COUNT) {
+                    std::fprintf(stderr, "unsupported dataset version %u\n", game_.version);
+                    return false;
+                }
+                ++game_index_;
+                continue;
+            }
+            if (record.magic != DATASET_ROWS_MAGIC || game_index_ < 0) continue;
+
+            if (buffer_.size() < sizeof(DatasetBatchHeader)) return corrupt();
+            std::memcpy(&batch.header, buffer_.data(), sizeof(batch.header));
+            batch.columns = dataset_columns(batch.header.rows, game_.radius);
+            if (buffer_.size() != sizeof(DatasetBatchHeader) + batch.columns[DATASET_COLUMN_COUNT]) return corrupt();
+            batch.game = &game_;
+            batch.game_index = game_index_;
+            batch.payload = buffer_.data() + sizeof(DatasetBatchHeader);
+            return true;
+        }
+    }
+
+private:
+    bool corrupt() {
+        std::fprintf(stderr, "truncated or corrupt record at offset %ld, stopping\n", std::ftell(file_));
+        return false;
+    }
+
+    FILE* file_ = nullptr;
+    vector<uint8_t> buffer_;
+    DatasetGameHeader game_;
+    int game_index_ = -1;
+};
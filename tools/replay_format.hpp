@@ -0,0 +1,143 @@
+#pragma once
+
+// Columnar replay corpus: a sequence of game blocks, one per ingested replay.
+//
+// Every block starts with a ReplayGameHeader, followed by these columns, each
+// starting on an 8-byte boundary. Per-turn rows of a table t live in
+// [t_begin[turn], t_begin[turn + 1]) of its columns.
+//
+//   initial_halite   uint16 [width * height]
+//   player_halite    uint32 [turns * players]     bank of each player after the turn
+//   delta_begin      uint32 [turns + 1]
+//   delta_cell       uint16 [deltas]              y * width + x
+//   delta_halite     uint16 [deltas]              new halite of the cell
+//   entity_begin     uint32 [turns + 1]
+//   entity_id        uint32 [entities]
+//   entity_owner     uint8  [entities]
+//   entity_x         uint8  [entities]
+//   entity_y         uint8  [entities]
+//   entity_cargo     uint16 [entities]
+//   command_begin    uint32 [turns + 1]
+//   command_ship     uint32 [commands]            REPLAY_NO_SHIP for spawns
+//   command_owner    uint8  [commands]
+//   command_type     uint8  [commands]            'm', 'c' or 'g'
+//   command_direction uint8 [commands]            'n', 's', 'e', 'w', 'o' (moves only)
+//
+// Readers memory-map the corpus (see MappedFile) and use ReplayGameView.
+
+#include "tools/mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+static const uint32_t REPLAY_MAGIC = 0x594c5052; // "RPLY"
+static const uint32_t REPLAY_VERSION = 1;
+static const uint32_t REPLAY_NO_SHIP = 0xffffffffu;
+
+struct ReplayGameHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t size;      // Whole block, header included
+    uint16_t width;
+    uint16_t height;
+    uint16_t players;
+    uint16_t reserved;
+    uint32_t turns;
+    uint32_t deltas;
+    uint32_t entities;
+    uint32_t commands;
+};
+
+static_assert(sizeof(ReplayGameHeader) == 40, "replay layout");
+
+inline size_t replay_align(size_t offset) {
+    return (offset + 7) & ~static_cast<size_t>(7);
+}
+
+// Offsets of every column of a block, relative to the block start
+struct ReplayLayout {
+    size_t initial_halite, player_halite;
+    size_t delta_begin, delta_cell, delta_halite;
+    size_t entity_begin, entity_id, entity_owner, entity_x, entity_y, entity_cargo;
+    size_t command_begin, command_ship, command_owner, command_type, command_direction;
+    size_t size;
+
+    explicit ReplayLayout(const ReplayGameHeader& h) {
+        size_t cells = static_cast<size_t>(h.width) * h.height;
+        size_t offset = sizeof(ReplayGameHeader);
+        auto column = [&](size_t bytes) {
+            size_t start = replay_align(offset);
+            offset = start + bytes;
+            return start;
+        };
+
+        initial_halite = column(cells * 2);
+        player_halite = column(static_cast<size_t>(h.turns) * h.players * 4);
+        delta_begin = column((h.turns + 1) * 4);
+        delta_cell = column(h.deltas * 2);
+        delta_halite = column(h.deltas * 2);
+        entity_begin = column((h.turns + 1) * 4);
+        entity_id = column(h.entities * 4);
+        entity_owner = column(h.entities);
+        entity_x = column(h.entities);
+        entity_y = column(h.entities);
+        entity_cargo = column(h.entities * 2);
+        command_begin = column((h.turns + 1) * 4);
+        command_ship = column(h.commands * 4);
+        command_owner = column(h.commands);
+        command_type = column(h.commands);
+        command_direction = column(h.commands);
+        size = replay_align(offset);
+    }
+};
+
+// Typed access to the columns of one game block, in place
+class ReplayGameView {
+public:
+    ReplayGameView(const uint8_t* block) : base_(block), header_(read_at<ReplayGameHeader>(block)), layout_(header_) {}
+
+    const ReplayGameHeader& header() const { return header_; }
+
+    uint16_t initial_halite(int x, int y) const { return u16(layout_.initial_halite, y * header_.width + x); }
+    uint32_t player_halite(uint32_t turn, int player) const { return u32(layout_.player_halite, turn * header_.players + player); }
+
+    uint32_t delta_begin(uint32_t turn) const { return u32(layout_.delta_begin, turn); }
+    uint16_t delta_cell(uint32_t i) const { return u16(layout_.delta_cell, i); }
+    uint16_t delta_halite(uint32_t i) const { return u16(layout_.delta_halite, i); }
+
+    uint32_t entity_begin(uint32_t turn) const { return u32(layout_.entity_begin, turn); }
+    uint32_t entity_id(uint32_t i) const { return u32(layout_.entity_id, i); }
+    uint8_t entity_owner(uint32_t i) const { return base_[layout_.entity_owner + i]; }
+    uint8_t entity_x(uint32_t i) const { return base_[layout_.entity_x + i]; }
+    uint8_t entity_y(uint32_t i) const { return base_[layout_.entity_y + i]; }
+    uint16_t entity_cargo(uint32_t i) const { return u16(layout_.entity_cargo, i); }
+
+    uint32_t command_begin(uint32_t turn) const { return u32(layout_.command_begin, turn); }
+    uint32_t command_ship(uint32_t i) const { return u32(layout_.command_ship, i); }
+    uint8_t command_owner(uint32_t i) const { return base_[layout_.command_owner + i]; }
+    char command_type(uint32_t i) const { return static_cast<char>(base_[layout_.command_type + i]); }
+    char command_direction(uint32_t i) const { return static_cast<char>(base_[layout_.command_direction + i]); }
+
+private:
+    uint16_t u16(size_t column, size_t i) const { return read_at<uint16_t>(base_ + column + i * 2); }
+    uint32_t u32(size_t column, size_t i) const { return read_at<uint32_t>(base_ + column + i * 4); }
+
+    const uint8_t* base_;
+    ReplayGameHeader header_;
+    ReplayLayout layout_;
+};
+
+// Calls f(ReplayGameView) for every complete game block of a corpus
+template <typename F>
+static size_t for_each_replay_game(const MappedFile& corpus, F&& f) {
+    size_t games = 0;
+    size_t offset = 0;
+    while (offset + sizeof(ReplayGameHeader) <= corpus.size()) {
+        ReplayGameHeader header = read_at<ReplayGameHeader>(corpus.data() + offset);
+        if (header.magic != REPLAY_MAGIC || header.version != REPLAY_VERSION || offset + header.size > corpus.size()) break;
+        f(ReplayGameView(corpus.data() + offset));
+        offset += header.size;
+        ++games;
+    }
+    return games;
+}
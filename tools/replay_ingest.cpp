@@ -0,0 +1,423 @@
+// Streams uncompressed Halite III JSON replays into a columnar corpus (see tools/replay_format.hpp).
+// Usage:
+//   replay_ingest <corpus> <replay.json>...   append every replay to the corpus
+//   replay_ingest --summary <corpus>          list the games of a corpus
+// Replays written by the engine are zstd-compressed: run `zstd -d` on them first
+// (or play with --no-compression). The JSON is parsed as a token stream, so memory
+// only holds the columns of the game being converted, never the document.
+
+#include "tools/replay_format.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// ---------------------------------------------------------------------------
+// Token-stream JSON reader
+
+template <typename Handler>
+class JsonStreamReader {
+public:
+    JsonStreamReader(FILE* file, Handler& handler) : file_(file), handler_(handler) {}
+
+    // Returns false on malformed input
+    bool parse() {
+        vector<char> containers;
+        bool expect_key = false;
+
+        for (;;) {
+            int c = next_non_space();
+            if (c == EOF) return containers.empty();
+
+            switch (c) {
+                case '{':
+                    handler_.begin_object();
+                    containers.push_back('{');
+                    expect_key = true;
+                    break;
+                case '[':
+                    handler_.begin_array();
+                    containers.push_back('[');
+                    expect_key = false;
+                    break;
+                case '}':
+                case ']':
+                    if (containers.empty()) return false;
+                    containers.pop_back();
+                    if (c == '}') handler_.end_object(); else handler_.end_array();
+                    expect_key = false;
+                    break;
+                case ',':
+                    expect_key = !containers.empty() && containers.back() == '{';
+                    break;
+                case ':':
+                    break;
+                case '"':
+                    if (!read_string()) return false;
+                    if (expect_key) handler_.key(text_); else handler_.text(text_);
+                    expect_key = false;
+                    break;
+                default:
+                    if (c == '-' || (c >= '0' && c <= '9')) {
+                        read_number(static_cast<char>(c));
+                        handler_.number(std::strtoll(text_.c_str(), nullptr, 10));
+                    }
+                    else if (c == 't' || c == 'f' || c == 'n') {
+                        // true / false / null
+                        int length = c == 'f' ? 4 : 3;
+                        for (int i = 0; i < length; ++i) get();
+                        handler_.literal(c == 't');
+                    }
+                    else {
+                        return false;
+                    }
+                    break;
+            }
+        }
+    }
+
+private:
+    int get() {
+        if (pos_ == len_) {
+            len_ = std::fread(buffer_, 1, sizeof(buffer_), file_);
+            pos_ = 0;
+            if (len_ == 0) return EOF;
+        }
+        return static_cast<unsigned char>(buffer_[pos_++]);
+    }
+
+    int peek() {
+        int c = get();
+        if (c != EOF) --pos_;
+        return c;
+    }
+
+    int next_non_space() {
+        int c;
+        do {
+            c = get();
+        } while (c == ' ' || c == '\n' || c == '\r' || c == '\t');
+        return c;
+    }
+
+    bool read_string() {
+        text_.clear();
+        for (;;) {
+            int c = get();
+            if (c == EOF) return false;
+            if (c == '"') return true;
+            if (c == '\\') {
+                c = get();
+                if (c == 'u') {
+                    // Replays only escape control characters; keep a placeholder
+                    for (int i = 0; i < 4; ++i) get();
+                    c = '?';
+                }
+                else if (c == 'n') c = '\n';
+                else if (c == 't') c = '\t';
+            }
+            text_.push_back(static_cast<char>(c));
+        }
+    }
+
+    // Integer part only: replays carry no fractional values in the fields we extract
+    void read_number(char first) {
+        text_.assign(1, first);
+        for (;;) {
+            int c = peek();
+            if (c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E' || (c >= '0' && c <= '9')) {
+                text_.push_back(static_cast<char>(get()));
+            }
+            else {
+                return;
+            }
+        }
+    }
+
+    FILE* file_;
+    Handler& handler_;
+    char buffer_[1 << 16];
+    size_t pos_ = 0;
+    size_t len_ = 0;
+    string text_;
+};
+
+// ---------------------------------------------------------------------------
+// Replay extraction
+
+// Collects the columns of one replay from the token stream.
+//
+// Replay keys are sorted, so "full_frames" comes before "number_of_players" and
+// "production_map": frames are stored with raw coordinates and player ids, and
+// laid out once the map size and player count are known.
+class ReplayBuilder {
+public:
+    void begin_object() { open(false); }
+    void begin_array() { open(true); }
+
+    void end_object() {
+        if (depth() == 3 && path_[0].key == "full_frames") {
+            close_turn();
+        }
+        else if (in_frame_list("cells", 5)) {
+            delta_x_.push_back(static_cast<uint16_t>(x_));
+            delta_y_.push_back(static_cast<uint16_t>(y_));
+            delta_halite_.push_back(static_cast<uint16_t>(std::min<long long>(value_, 0xffff)));
+        }
+        else if (in_frame_map("entities") && depth() == 6) {
+            entity_id_.push_back(static_cast<uint32_t>(std::atol(path_[4].key.c_str())));
+            entity_owner_.push_back(static_cast<uint8_t>(std::atoi(path_[3].key.c_str())));
+            entity_x_.push_back(static_cast<uint8_t>(x_));
+            entity_y_.push_back(static_cast<uint8_t>(y_));
+            entity_cargo_.push_back(static_cast<uint16_t>(std::min<long long>(value_, 0xffff)));
+        }
+        else if (in_frame_map("moves") && depth() == 6) {
+            command_ship_.push_back(ship_ < 0 ? REPLAY_NO_SHIP : static_cast<uint32_t>(ship_));
+            command_owner_.push_back(static_cast<uint8_t>(std::atoi(path_[3].key.c_str())));
+            command_type_.push_back(static_cast<uint8_t>(type_));
+            command_direction_.push_back(static_cast<uint8_t>(direction_));
+        }
+        close();
+    }
+
+    void end_array() { close(); }
+
+    void key(const string& k) {
+        path_.back().key = k;
+    }
+
+    void number(long long v) {
+        element();
+        const string& k = path_.back().key;
+
+        if (depth() == 1 && k == "number_of_players") {
+            players_ = static_cast<int>(v);
+        }
+        else if (depth() == 2 && path_[0].key == "production_map") {
+            if (k == "width") width_ = static_cast<int>(v);
+            if (k == "height") height_ = static_cast<int>(v);
+        }
+        else if (depth() == 5 && path_[0].key == "production_map" && path_[1].key == "grid" && k == "energy") {
+            if (path_[3].index == 0) ++grid_rows_;
+            initial_halite_.push_back(static_cast<uint16_t>(std::min<long long>(v, 0xffff)));
+        }
+        else if (in_frame_map("energy") && depth() == 4) {
+            bank_owner_.push_back(static_cast<uint8_t>(std::atoi(k.c_str())));
+            bank_value_.push_back(static_cast<uint32_t>(v));
+        }
+        else if ((in_frame_list("cells", 5) || (in_frame_map("entities") && depth() == 6)) || (in_frame_map("moves") && depth() == 6)) {
+            if (k == "x") x_ = static_cast<int>(v);
+            else if (k == "y") y_ = static_cast<int>(v);
+            else if (k == "production" || k == "energy") value_ = v;
+            else if (k == "id") ship_ = v;
+        }
+    }
+
+    void text(const std::string& v) {
+        element();
+        if (in_frame_map("moves") && depth() == 6 && !v.empty()) {
+            const std::string& k = path_.back().key;
+            if (k == "type") type_ = v[0];
+            else if (k == "direction") direction_ = v[0];
+        }
+    }
+
+    void literal(bool) { element(); }
+
+    // Write the game block. Returns false if the replay lacked the map.
+    bool write(FILE* out) {
+        if (grid_rows_ > 0 && width_ == 0) width_ = static_cast<int>(initial_halite_.size()) / grid_rows_;
+        if (grid_rows_ > 0 && height_ == 0) height_ = grid_rows_;
+        if (width_ <= 0 || height_ <= 0 || initial_halite_.size() != static_cast<size_t>(width_) * height_) return false;
+
+        int players = players_;
+        for (uint8_t owner : bank_owner_) players = std::max(players, owner + 1);
+
+        ReplayGameHeader header;
+        header.magic = REPLAY_MAGIC;
+        header.version = REPLAY_VERSION;
+        header.width = static_cast<uint16_t>(width_);
+        header.height = static_cast<uint16_t>(height_);
+        header.players = static_cast<uint16_t>(players);
+        header.reserved = 0;
+        header.turns = static_cast<uint32_t>(delta_begin_.size() - 1);
+        header.deltas = static_cast<uint32_t>(delta_x_.size());
+        header.entities = static_cast<uint32_t>(entity_id_.size());
+        header.commands = static_cast<uint32_t>(command_ship_.size());
+        ReplayLayout layout(header);
+        header.size = layout.size;
+
+        // Cells and banks are resolved now that the map size and player count are known
+        vector<uint16_t> delta_cell(delta_x_.size());
+        for (size_t i = 0; i < delta_cell.size(); ++i) delta_cell[i] = static_cast<uint16_t>(delta_y_[i] * width_ + delta_x_[i]);
+
+        vector<uint32_t> player_halite(static_cast<size_t>(header.turns) * players, 0);
+        for (uint32_t turn = 0; turn < header.turns; ++turn) {
+            for (uint32_t i = bank_begin_[turn]; i < bank_begin_[turn + 1]; ++i) {
+                player_halite[turn * players + bank_owner_[i]] = bank_value_[i];
+            }
+        }
+
+        vector<uint8_t> block(layout.size, 0);
+        auto put = [&](size_t offset, const void* data, size_t bytes) {
+            if (bytes) std::memcpy(&block[offset], data, bytes);
+        };
+        put(0, &header, sizeof(header));
+        put(layout.initial_halite, initial_halite_.data(), initial_halite_.size() * 2);
+        put(layout.player_halite, player_halite.data(), player_halite.size() * 4);
+        put(layout.delta_begin, delta_begin_.data(), delta_begin_.size() * 4);
+        put(layout.delta_cell, delta_cell.data(), delta_cell.size() * 2);
+        put(layout.delta_halite, delta_halite_.data(), delta_halite_.size() * 2);
+        put(layout.entity_begin, entity_begin_.data(), entity_begin_.size() * 4);
+        put(layout.entity_id, entity_id_.data(), entity_id_.size() * 4);
+        put(layout.entity_owner, entity_owner_.data(), entity_owner_.size());
+        put(layout.entity_x, entity_x_.data(), entity_x_.size());
+        put(layout.entity_y, entity_y_.data(), entity_y_.size());
+        put(layout.entity_cargo, entity_cargo_.data(), entity_cargo_.size() * 2);
+        put(layout.command_begin, command_begin_.data(), command_begin_.size() * 4);
+        put(layout.command_ship, command_ship_.data(), command_ship_.size() * 4);
+        put(layout.command_owner, command_owner_.data(), command_owner_.size());
+        put(layout.command_type, command_type_.data(), command_type_.size());
+        put(layout.command_direction, command_direction_.data(), command_direction_.size());
+
+        return std::fwrite(block.data(), 1, block.size(), out) == block.size();
+    }
+
+    uint32_t turns() const { return static_cast<uint32_t>(delta_begin_.size() - 1); }
+
+private:
+    struct Level {
+        bool is_array;
+        int index;          // Current element (arrays)
+        std::string key;    // Current member (objects)
+    };
+
+    int depth() const { return static_cast<int>(path_.size()); }
+
+    // Arrays count their elements as they start
+    void element() {
+        if (!path_.empty() && path_.back().is_array) ++path_.back().index;
+    }
+
+    void open(bool is_array) {
+        element();
+        path_.push_back(Level{ is_array, -1, std::string() });
+        x_ = 0;
+        y_ = 0;
+        value_ = 0;
+        ship_ = -1;
+        type_ = 0;
+        direction_ = 0;
+    }
+
+    void close() {
+        path_.pop_back();
+    }
+
+    // Inside full_frames[f].<name>[i] objects at the given depth
+    bool in_frame_list(const char* name, int at_depth) const {
+        return depth() == at_depth && path_[0].key == "full_frames" && path_[2].key == name;
+    }
+
+    // Inside full_frames[f].<name> (any depth below it)
+    bool in_frame_map(const char* name) const {
+        return depth() >= 3 && path_[0].key == "full_frames" && path_[2].key == name;
+    }
+
+    void close_turn() {
+        delta_begin_.push_back(static_cast<uint32_t>(delta_x_.size()));
+        entity_begin_.push_back(static_cast<uint32_t>(entity_id_.size()));
+        command_begin_.push_back(static_cast<uint32_t>(command_ship_.size()));
+        bank_begin_.push_back(static_cast<uint32_t>(bank_owner_.size()));
+    }
+
+    vector<Level> path_;
+    int width_ = 0;
+    int height_ = 0;
+    int players_ = 0;
+    int grid_rows_ = 0;
+
+    // Fields of the object being read
+    int x_ = 0;
+    int y_ = 0;
+    long long value_ = 0;
+    long long ship_ = -1;
+    char type_ = 0;
+    char direction_ = 0;
+
+    vector<uint16_t> initial_halite_;
+    vector<uint32_t> delta_begin_ = { 0 };
+    vector<uint16_t> delta_x_, delta_y_, delta_halite_;
+    vector<uint32_t> entity_begin_ = { 0 };
+    vector<uint32_t> entity_id_;
+    vector<uint8_t> entity_owner_, entity_x_, entity_y_;
+    vector<uint16_t> entity_cargo_;
+    vector<uint32_t> command_begin_ = { 0 };
+    vector<uint32_t> command_ship_;
+    vector<uint8_t> command_owner_, command_type_, command_direction_;
+    vector<uint32_t> bank_begin_ = { 0 };
+    vector<uint8_t> bank_owner_;
+    vector<uint32_t> bank_value_;
+};
+
+static int summarize(const char* path) {
+    MappedFile corpus;
+    if (!corpus.open(path)) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return 1;
+    }
+
+    size_t games = for_each_replay_game(corpus, [](const ReplayGameView& game) {
+        const ReplayGameHeader& h = game.header();
+        printf("%ux%u, %u players, %u turns, %u deltas, %u entity rows, %u commands, final banks:",
+            h.width, h.height, h.players, h.turns, h.deltas, h.entities, h.commands);
+        for (int p = 0; p < h.players && h.turns > 0; ++p) printf(" %u", game.player_halite(h.turns - 1, p));
+        printf("\n");
+    });
+    printf("%zu games, %zu bytes\n", games, corpus.size());
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <corpus> <replay.json>... | --summary <corpus>\n", argv[0]);
+        return 2;
+    }
+    if (std::string(argv[1]) == "--summary") return summarize(argv[2]);
+
+    FILE* out = std::fopen(argv[1], "ab");
+    if (!out) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    int failures = 0;
+    for (int i = 2; i < argc; ++i) {
+        FILE* in = std::fopen(argv[i], "rb");
+        if (!in) {
+            fprintf(stderr, "%s: cannot open\n", argv[i]);
+            ++failures;
+            continue;
+        }
+
+        ReplayBuilder builder;
+        JsonStreamReader<ReplayBuilder> reader(in, builder);
+        bool parsed = reader.parse();
+        std::fclose(in);
+
+        if (!parsed || !builder.write(out)) {
+            fprintf(stderr, "%s: not a readable uncompressed replay\n", argv[i]);
+            ++failures;
+            continue;
+        }
+        printf("%s: %u turns\n", argv[i], builder.turns());
+    }
+
+    std::fclose(out);
+    return failures ? 1 : 0;
+}
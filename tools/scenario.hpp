@@ -0,0 +1,245 @@
+// Synthetic games in the engine's input format: a symmetric fractal halite map,
+// player yards and a fleet layout, then frames in which every ship wanders.
+// The result is a transcript the bot can be driven by (see tools/bench_scale.cpp),
+// for map sizes, player counts and fleet sizes no recorded game covers.
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+enum class FleetLayout {
+    CLUSTERED, // Around each yard, denser near it
+    SPREAD,    // Anywhere in the player's part of the map
+    PILE_UP    // Packed next to each yard with full cargo, in the last turns of the game
+};
+
+inline const char* fleet_layout_name(FleetLayout layout) {
+    switch (layout) {
+        case FleetLayout::CLUSTERED: return "clustered";
+        case FleetLayout::SPREAD: return "spread";
+        default: return "pile_up";
+    }
+}
+
+struct ScenarioConfig {
+    int size = 64;
+    int players = 4;              // 2 or 4
+    int ships_per_player = 50;
+    FleetLayout layout = FleetLayout::CLUSTERED;
+    int turns = 50;               // Frames written
+    uint32_t seed = 1;
+};
+
+struct ScenarioShip {
+    int id;
+    int x;
+    int y;
+    int halite;
+};
+
+class Scenario {
+public:
+    explicit Scenario(const ScenarioConfig& config)
+        : config_(config), rng_(config.seed), halite_(config.size * config.size, 0), occupied_(config.size * config.size, false) {
+        generate_map();
+        place_yards();
+        place_fleets();
+    }
+
+    const ScenarioConfig& config() const { return config_; }
+    int max_turns() const { return config_.layout == FleetLayout::PILE_UP ? config_.turns + 10 : 500; }
+    int first_turn() const { return config_.layout == FleetLayout::PILE_UP ? 11 : 1; }
+
+    // Everything the engine sends to player my_id for the whole game
+    void write(std::ostream& out, int my_id = 0) {
+        int n = config_.size;
+        out << "{\"NEW_ENTITY_ENERGY_COST\": 1000, \"DROPOFF_COST\": 4000, \"MAX_ENERGY\": 1000, \"MAX_TURNS\": " << max_turns()
+            << ", \"EXTRACT_RATIO\": 4, \"MOVE_COST_RATIO\": 10, \"INSPIRATION_ENABLED\": true, \"INSPIRATION_RADIUS\": 4,"
+            << " \"INSPIRATION_SHIP_COUNT\": 2, \"INSPIRED_EXTRACT_RATIO\": 4, \"INSPIRED_BONUS_MULTIPLIER\": 2.0,"
+            << " \"INSPIRED_MOVE_COST_RATIO\": 10, \"CAPTURE_ENABLED\": false}\n";
+        out << config_.players << ' ' << my_id << '\n';
+        for (int p = 0; p < config_.players; ++p) out << p << ' ' << yards_[p].first << ' ' << yards_[p].second << '\n';
+        out << n << ' ' << n << '\n';
+        for (int y = 0; y < n; ++y) {
+            for (int x = 0; x < n; ++x) out << halite_[y * n + x] << (x + 1 < n ? ' ' : '\n');
+        }
+
+        for (int t = 0; t < config_.turns; ++t) {
+            out << first_turn() + t << '\n';
+            for (int p = 0; p < config_.players; ++p) {
+                out << p << ' ' << fleets_[p].size() << " 0 " << 5000 << '\n';
+                for (const auto& ship : fleets_[p]) out << ship.id << ' ' << ship.x << ' ' << ship.y << ' ' << ship.halite << '\n';
+            }
+            write_changes(out);
+            advance();
+        }
+    }
+
+private:
+    int cell(int x, int y) const { return y * config_.size + x; }
+    int wrap(int v) const { return (v % config_.size + config_.size) % config_.size; }
+
+    // Octaves of bilinear value noise on one symmetry region, squared so rich patches stand out,
+    // then mirrored across the map (left/right for 2 players, and top/bottom for 4)
+    void generate_map() {
+        int n = config_.size;
+        int region_w = n / 2;
+        int region_h = config_.players == 4 ? n / 2 : n;
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        std::vector<double> value(region_w * region_h, 0.0);
+        double amplitude = 1.0;
+        double total_amplitude = 0.0;
+        for (int period = std::max(region_w, region_h) / 2; period >= 2; period /= 2) {
+            int gw = region_w / period + 2;
+            int gh = region_h / period + 2;
+            std::vector<double> lattice(gw * gh);
+            for (auto& v : lattice) v = unit(rng_);
+            for (int y = 0; y < region_h; ++y) {
+                for (int x = 0; x < region_w; ++x) {
+                    double fx = static_cast<double>(x) / period;
+                    double fy = static_cast<double>(y) / period;
+                    int ix = static_cast<int>(fx);
+                    int iy = static_cast<int>(fy);
+                    double tx = fx - ix;
+                    double ty = fy - iy;
+                    double top = lattice[iy * gw + ix] * (1 - tx) + lattice[iy * gw + ix + 1] * tx;
+                    double bottom = lattice[(iy + 1) * gw + ix] * (1 - tx) + lattice[(iy + 1) * gw + ix + 1] * tx;
+                    value[y * region_w + x] += amplitude * (top * (1 - ty) + bottom * ty);
+                }
+            }
+            total_amplitude += amplitude;
+            amplitude *= 0.5;
+        }
+
+        for (int y = 0; y < region_h; ++y) {
+            for (int x = 0; x < region_w; ++x) {
+                double v = value[y * region_w + x] / total_amplitude;
+                int h = static_cast<int>(std::pow(v, 4.0) * 2500.0);
+                h = std::min(h, 1000);
+                halite_[cell(x, y)] = h;
+                halite_[cell(n - 1 - x, y)] = h;
+                if (config_.players == 4) {
+                    halite_[cell(x, n - 1 - y)] = h;
+                    halite_[cell(n - 1 - x, n - 1 - y)] = h;
+                }
+            }
+        }
+    }
+
+    void place_yards() {
+        int n = config_.size;
+        int a = n / 4;
+        int b = n - 1 - n / 4;
+        if (config_.players == 2) {
+            yards_ = { { a, n / 2 }, { b, n / 2 } };
+        }
+        else {
+            yards_ = { { a, a }, { b, a }, { a, b }, { b, b } };
+        }
+    }
+
+    // Mirror of player 0's offset (dx, dy) from its yard for player p
+    std::pair<int, int> mirrored(int p, int dx, int dy) const {
+        bool flip_x = (p % 2) == 1;
+        bool flip_y = config_.players == 4 && p >= 2;
+        return { yards_[p].first + (flip_x ? -dx : dx), yards_[p].second + (flip_y ? -dy : dy) };
+    }
+
+    void place_fleets() {
+        int n = config_.size;
+        int region_w = n / 2;
+        int region_h = config_.players == 4 ? n / 2 : n;
+        int count = std::min(config_.ships_per_player, region_w * region_h / 2);
+        int radius = 1;
+        if (config_.layout == FleetLayout::CLUSTERED) radius = std::max(2, static_cast<int>(std::sqrt(count * 2.0)));
+        if (config_.layout == FleetLayout::PILE_UP) radius = std::max(2, static_cast<int>(std::sqrt(count * 0.6)));
+
+        std::uniform_int_distribution<int> cargo(0, 1000);
+        fleets_.assign(config_.players, {});
+        int next_id = 0;
+        int attempts = 0;
+        while (static_cast<int>(fleets_[0].size()) < count && attempts < count * 1000) {
+            ++attempts;
+            int dx;
+            int dy;
+            if (config_.layout == FleetLayout::SPREAD) {
+                dx = std::uniform_int_distribution<int>(-region_w / 2, region_w / 2 - 1)(rng_);
+                dy = std::uniform_int_distribution<int>(-region_h / 2, region_h / 2 - 1)(rng_);
+            }
+            else {
+                // Clustered: radius drawn as the product of two uniforms, so the density peaks at the yard
+                std::uniform_int_distribution<int> r(0, radius);
+                int extent = config_.layout == FleetLayout::CLUSTERED ? r(rng_) * r(rng_) / std::max(radius, 1) + 1 : radius;
+                dx = std::uniform_int_distribution<int>(-extent, extent)(rng_);
+                dy = std::uniform_int_distribution<int>(-extent, extent)(rng_);
+            }
+            if (dx == 0 && dy == 0) continue;
+
+            // The same offset (mirrored) must be free for every player
+            bool free = true;
+            for (int p = 0; p < config_.players && free; ++p) {
+                std::pair<int, int> at = mirrored(p, dx, dy);
+                if (occupied_[cell(wrap(at.first), wrap(at.second))]) free = false;
+            }
+            if (!free) continue;
+
+            int halite = config_.layout == FleetLayout::PILE_UP ? 900 + cargo(rng_) / 10 : cargo(rng_);
+            for (int p = 0; p < config_.players; ++p) {
+                std::pair<int, int> at = mirrored(p, dx, dy);
+                ScenarioShip ship = { next_id++, wrap(at.first), wrap(at.second), halite };
+                occupied_[cell(ship.x, ship.y)] = true;
+                fleets_[p].push_back(ship);
+            }
+        }
+    }
+
+    // Halite cells under ships that stayed lose a quarter, as if mined
+    void write_changes(std::ostream& out) {
+        out << changes_.size() << '\n';
+        for (int c : changes_) out << c % config_.size << ' ' << c / config_.size << ' ' << halite_[c] << '\n';
+    }
+
+    // Every ship stays and mines, or steps to a free neighbour
+    void advance() {
+        changes_.clear();
+        std::uniform_int_distribution<int> move(0, 4);
+        static const int dx[] = { 0, 0, 1, -1, 0 };
+        static const int dy[] = { -1, 1, 0, 0, 0 };
+        for (auto& fleet : fleets_) {
+            for (auto& ship : fleet) {
+                int m = move(rng_);
+                int nx = wrap(ship.x + dx[m]);
+                int ny = wrap(ship.y + dy[m]);
+                if (m == 4 || occupied_[cell(nx, ny)]) {
+                    int& h = halite_[cell(ship.x, ship.y)];
+                    int mined = std::min((h + 3) / 4, 1000 - ship.halite);
+                    if (mined > 0) {
+                        h -= mined;
+                        ship.halite += mined;
+                        changes_.push_back(cell(ship.x, ship.y));
+                    }
+                    continue;
+                }
+                occupied_[cell(ship.x, ship.y)] = false;
+                occupied_[cell(nx, ny)] = true;
+                ship.halite -= std::min(ship.halite, halite_[cell(ship.x, ship.y)] / 10);
+                ship.x = nx;
+                ship.y = ny;
+            }
+        }
+    }
+
+    ScenarioConfig config_;
+    std::mt19937 rng_;
+    std::vector<int> halite_;
+    std::vector<bool> occupied_;
+    std::vector<std::pair<int, int>> yards_;
+    std::vector<std::vector<ScenarioShip>> fleets_;
+    std::vector<int> changes_;
+};
@@ -0,0 +1,170 @@
+// Extracts turns and ship timelines from a snapshot archive (see hlt/bot_snapshot.hpp).
+// Usage:
+//   snapshot_reader <archive> games
+//   snapshot_reader <archive> turn <game> <turn>
+//   snapshot_reader <archive> ship <game> <ship_id>
+// The archive is memory-mapped and only record headers are read to find a turn,
+// so lookups stay fast on multi-GB archives.
+
+#include "hlt/bot_snapshot.hpp"
+
+#include "tools/mapped_file.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct GameIndex {
+    SnapshotGameHeader header;
+    vector<size_t> turn_offsets; // Offsets of the TURN records, in file order
+};
+
+// One pass over the record headers
+static vector<GameIndex> build_index(const MappedFile& archive) {
+    vector<GameIndex> games;
+    size_t offset = 0;
+    while (offset + sizeof(SnapshotRecordHeader) <= archive.size()) {
+        SnapshotRecordHeader record = read_at<SnapshotRecordHeader>(archive.data() + offset);
+        if (record.size < sizeof(SnapshotRecordHeader) || offset + record.size > archive.size()) {
+            fprintf(stderr, "truncated or corrupt record at offset %zu, stopping\n", offset);
+            break;
+        }
+
+        if (record.magic == SNAPSHOT_GAME_MAGIC) {
+            GameIndex game;
+            game.header = read_at<SnapshotGameHeader>(archive.data() + offset + sizeof(SnapshotRecordHeader));
+            games.push_back(game);
+        }
+        else if (record.magic == SNAPSHOT_TURN_MAGIC && !games.empty()) {
+            games.back().turn_offsets.push_back(offset);
+        }
+        offset += record.size;
+    }
+    return games;
+}
+
+struct TurnView {
+    SnapshotTurnHeader header;
+    const uint8_t* grids;
+    size_t grid_bytes;
+    const uint8_t* ships;
+
+    bool bit(int grid, int cell) const {
+        return (grids[grid * grid_bytes + (cell >> 3)] >> (cell & 7)) & 1;
+    }
+
+    SnapshotShip ship(int i) const { return read_at<SnapshotShip>(ships + i * sizeof(SnapshotShip)); }
+};
+
+static TurnView view_turn(const MappedFile& archive, const GameIndex& game, size_t offset) {
+    TurnView view;
+    const uint8_t* p = archive.data() + offset + sizeof(SnapshotRecordHeader);
+    view.header = read_at<SnapshotTurnHeader>(p);
+    view.grids = p + sizeof(SnapshotTurnHeader);
+    view.grid_bytes = snapshot_grid_bytes(game.header.width, game.header.height);
+    view.ships = view.grids + view.header.grid_count * view.grid_bytes;
+    return view;
+}
+
+static const char* status_name(uint8_t status) {
+    return status == static_cast<uint8_t>(ShipState::RETURNING) ? "returning" : "mining";
+}
+
+static void print_turn(const GameIndex& game, const TurnView& turn) {
+    int width = game.header.width;
+    int height = game.header.height;
+    printf("turn %u  halite %u  ships %u\n", turn.header.turn, turn.header.halite, turn.header.ship_count);
+
+    // One character per cell: ship command / D danger / C claimed / o occupied / i inspired
+    vector<char> cells(static_cast<size_t>(width) * height, '.');
+    for (int cell = 0; cell < width * height; ++cell) {
+        if (turn.bit(SNAPSHOT_INSPIRED, cell)) cells[cell] = 'i';
+        if (turn.bit(SNAPSHOT_OCCUPIED, cell)) cells[cell] = 'o';
+        if (turn.bit(SNAPSHOT_CLAIMED, cell)) cells[cell] = 'C';
+        if (turn.bit(SNAPSHOT_DANGER, cell)) cells[cell] = 'D';
+    }
+    for (int i = 0; i < turn.header.ship_count; ++i) {
+        SnapshotShip ship = turn.ship(i);
+        cells[ship.y * width + ship.x] = ship.command ? static_cast<char>(ship.command - 'a' + 'A') : '?';
+    }
+    for (int y = 0; y < height; ++y) {
+        printf("%.*s\n", width, &cells[static_cast<size_t>(y) * width]);
+    }
+
+    printf("%6s %7s %7s %5s %-9s %s\n", "ship", "pos", "target", "cargo", "status", "cmd");
+    for (int i = 0; i < turn.header.ship_count; ++i) {
+        SnapshotShip ship = turn.ship(i);
+        printf("%6u %3u,%-3u %3u,%-3u %5u %-9s %c\n",
+            ship.id, ship.x, ship.y, ship.target_x, ship.target_y, ship.cargo,
+            status_name(ship.status), ship.command ? ship.command : '-');
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <archive> games | turn <game> <turn> | ship <game> <ship_id>\n", argv[0]);
+        return 2;
+    }
+
+    MappedFile archive;
+    if (!archive.open(argv[1])) {
+        fprintf(stderr, "cannot open %s\n", argv[1]);
+        return 1;
+    }
+    vector<GameIndex> games = build_index(archive);
+    string query = argv[2];
+
+    if (query == "games") {
+        for (size_t g = 0; g < games.size(); ++g) {
+            const SnapshotGameHeader& h = games[g].header;
+            printf("game %zu: %ux%u, player %u of %u, %zu turns\n",
+                g, h.width, h.height, h.my_id, h.num_players, games[g].turn_offsets.size());
+        }
+        return 0;
+    }
+
+    if (argc < 5) {
+        fprintf(stderr, "missing arguments for %s\n", query.c_str());
+        return 2;
+    }
+    size_t g = static_cast<size_t>(stoul(argv[3]));
+    if (g >= games.size()) {
+        fprintf(stderr, "no game %zu (%zu in archive)\n", g, games.size());
+        return 1;
+    }
+    const GameIndex& game = games[g];
+
+    if (query == "turn") {
+        uint32_t turn = static_cast<uint32_t>(stoul(argv[4]));
+        for (size_t offset : game.turn_offsets) {
+            TurnView view = view_turn(archive, game, offset);
+            if (view.header.turn == turn) {
+                print_turn(game, view);
+                return 0;
+            }
+        }
+        fprintf(stderr, "no turn %u in game %zu\n", turn, g);
+        return 1;
+    }
+
+    if (query == "ship") {
+        uint32_t id = static_cast<uint32_t>(stoul(argv[4]));
+        printf("%5s %7s %7s %5s %-9s %s\n", "turn", "pos", "target", "cargo", "status", "cmd");
+        for (size_t offset : game.turn_offsets) {
+            TurnView view = view_turn(archive, game, offset);
+            for (int i = 0; i < view.header.ship_count; ++i) {
+                SnapshotShip ship = view.ship(i);
+                if (ship.id != id) continue;
+                printf("%5u %3u,%-3u %3u,%-3u %5u %-9s %c\n",
+                    view.header.turn, ship.x, ship.y, ship.target_x, ship.target_y, ship.cargo,
+                    status_name(ship.status), ship.command ? ship.command : '-');
+            }
+        }
+        return 0;
+    }
+
+    fprintf(stderr, "unknown query %s\n", query.c_str());
+    return 2;
+}